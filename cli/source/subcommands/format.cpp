@@ -20,7 +20,10 @@ namespace pl::cli::sub {
         static bool verbose = false;
         static bool allowDangerousFunctions = false;
         static bool metaInformation = false;
+        static bool parallelFormatting = false;
+        static bool streamPatterns = false;
         static u64 baseAddress = 0x00;
+        static u64 pageSize = 0x00;
 
         auto subcommand = app->add_subcommand("format");
 
@@ -34,6 +37,9 @@ namespace pl::cli::sub {
         subcommand->add_flag("-v,--verbose", verbose, "Verbose output")->default_val(false);
         subcommand->add_flag("-d,--dangerous", allowDangerousFunctions, "Allow dangerous functions")->default_val(false);
         subcommand->add_flag("-m,--metadata", metaInformation, "Include meta type information")->default_val(0x00);
+        subcommand->add_flag("-j,--parallel", parallelFormatting, "Format patterns on multiple threads")->default_val(false);
+        subcommand->add_flag("-s,--stream", streamPatterns, "Write json output while the pattern is running and release each top-level pattern once written")->default_val(false);
+        subcommand->add_option("--page-size", pageSize, "Split html output into multiple files showing this many bytes each")->default_val(0x00);
         subcommand->add_option("-f,--formatter", formatterName, "Formatter")->default_val("default")->check([&](const auto &value) -> std::string {
             // Validate if the selected formatter exists
             if (std::any_of(formatters.begin(), formatters.end(), [&](const auto &formatter) { return formatter->getName() == value; }))
@@ -58,6 +64,19 @@ namespace pl::cli::sub {
                                                       return formatter->getName() == formatterName;
                                                   });
 
+            // Only the html formatter knows how to split its output into pages
+            if (pageSize > 0 && dynamic_cast<pl::gen::fmt::FormatterHtml*>(formatter.get()) == nullptr) {
+                ::fmt::print("--page-size is only supported by the html formatter\n");
+                std::exit(EXIT_FAILURE);
+            }
+
+            // Only the json formatter can write patterns one at a time
+            auto jsonFormatter = dynamic_cast<pl::gen::fmt::FormatterJson*>(formatter.get());
+            if (streamPatterns && jsonFormatter == nullptr) {
+                ::fmt::print("--stream is only supported by the json formatter\n");
+                std::exit(EXIT_FAILURE);
+            }
+
             // If no output path was given, use the input path with the formatter's file extension
             if (outputFilePath.empty()) {
                 outputFilePath = inputFilePath;
@@ -78,9 +97,44 @@ namespace pl::cli::sub {
                 std::exit(EXIT_FAILURE);
             }
 
+            // Set formatter settings
+            formatter->enableMetaInformation(metaInformation);
+            formatter->enableParallelFormatting(parallelFormatting);
+
+            const auto createOutputFile = [] {
+                wolv::io::File outputFile(outputFilePath, wolv::io::File::Mode::Create);
+                if (!outputFile.isValid()) {
+                    ::fmt::print("Failed to create output file: {}\n", outputFilePath.string());
+                    std::exit(EXIT_FAILURE);
+                }
+
+                return outputFile;
+            };
+
             // Create and configure Pattern Language runtime
             pl::PatternLanguage runtime;
-            pl::cli::executePattern(runtime, inputFile, patternFile, includePaths, defines, allowDangerousFunctions, baseAddress);
+
+            if (streamPatterns) {
+                // Patterns are written by the pattern sink as soon as they're complete. None of them are kept, so memory
+                // usage doesn't grow with the size of the input
+                auto outputFile = createOutputFile();
+                pl::gen::fmt::BufferedOutput output([&](const u8 *data, size_t size) {
+                    outputFile.writeBuffer(data, size);
+                });
+
+                {
+                    pl::gen::fmt::FormatterJson::PatternWriter writer(*jsonFormatter, output);
+                    runtime.setPatternSink([&writer](const std::shared_ptr<pl::ptrn::Pattern> &pattern) {
+                        writer.write(*pattern);
+                        return false;
+                    });
+
+                    pl::cli::executePattern(runtime, inputFile, patternFile, includePaths, defines, allowDangerousFunctions, baseAddress);
+                }
+                output.flush();
+            } else {
+                pl::cli::executePattern(runtime, inputFile, patternFile, includePaths, defines, allowDangerousFunctions, baseAddress);
+            }
 
             // Output console log if verbose mode is enabled
             if (verbose) {
@@ -104,20 +158,54 @@ namespace pl::cli::sub {
                 }
             }
 
-            // Set formatter settings
-            formatter->enableMetaInformation(metaInformation);
+            if (streamPatterns)
+                return;
 
-            // Call selected formatter to format the results
-            auto result = formatter->format(runtime);
+            // Large html exports are split up into multiple files that link to each other
+            if (auto htmlFormatter = dynamic_cast<pl::gen::fmt::FormatterHtml*>(formatter.get()); htmlFormatter != nullptr && pageSize > 0) {
+                htmlFormatter->setPageSize(pageSize);
 
-            // Write results to output file
-            wolv::io::File outputFile(outputFilePath, wolv::io::File::Mode::Create);
-            if (!outputFile.isValid()) {
-                ::fmt::print("Failed to create output file: {}\n", outputFilePath.string());
-                std::exit(EXIT_FAILURE);
+                const auto getPagePath = [&](u64 page) {
+                    if (page == 0)
+                        return outputFilePath;
+
+                    auto path = outputFilePath;
+                    path.replace_filename(::fmt::format("{}_{}{}", outputFilePath.stem().string(), page, outputFilePath.extension().string()));
+
+                    return path;
+                };
+
+                const auto pageCount = htmlFormatter->getPageCount(runtime);
+                for (u64 page = 0; page < pageCount; page++) {
+                    wolv::io::File pageFile(getPagePath(page), wolv::io::File::Mode::Create);
+                    if (!pageFile.isValid()) {
+                        ::fmt::print("Failed to create output file: {}\n", getPagePath(page).string());
+                        std::exit(EXIT_FAILURE);
+                    }
+
+                    pl::gen::fmt::BufferedOutput output([&](const u8 *data, size_t size) {
+                        pageFile.writeBuffer(data, size);
+                    });
+
+                    htmlFormatter->formatPage(runtime, page, output, [&](u64 linkedPage) {
+                        return getPagePath(linkedPage).filename().string();
+                    });
+                    output.flush();
+                }
+
+                return;
             }
 
-            outputFile.writeVector(result);
+            // Create output file
+            auto outputFile = createOutputFile();
+
+            // Call selected formatter to write the results straight to the output file
+            pl::gen::fmt::BufferedOutput output([&](const u8 *data, size_t size) {
+                outputFile.writeBuffer(data, size);
+            });
+
+            formatter->format(runtime, output);
+            output.flush();
         });
     }
 
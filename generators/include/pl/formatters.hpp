@@ -4,6 +4,8 @@
 #include <pl/formatters/formatter_json.hpp>
 #include <pl/formatters/formatter_yaml.hpp>
 #include <pl/formatters/formatter_html.hpp>
+#include <pl/formatters/formatter_binary.hpp>
+#include <pl/formatters/formatter_columnar.hpp>
 
 namespace pl::gen::fmt {
 
@@ -11,7 +13,9 @@ namespace pl::gen::fmt {
     using Formatters = std::tuple<
             FormatterJson,
             FormatterYaml,
-            FormatterHtml
+            FormatterHtml,
+            FormatterBinary,
+            FormatterColumnar
     >;
 
 
@@ -0,0 +1,132 @@
+#pragma once
+
+#include <pl/helpers/types.hpp>
+
+#include <array>
+#include <cstring>
+#include <span>
+#include <stdexcept>
+
+/**
+ * Layout of the binary result format written by FormatterBinary and read by BinaryResultReader
+ *
+ * Header:  Magic "PLB\0", version byte, flags byte (see Flags)
+ * Node:    Tag byte, name reference, meta information if enabled, payload depending on the tag
+ * Meta:    Type name reference, offset, size, color (u32 little endian), endian byte (0 = little, 1 = big), comment reference
+ *
+ * All other integers are LEB128 encoded, signed ones are zigzag encoded first. Names are interned. A reference is either the
+ * index of a previously defined name, zero for none, or the next free index followed by the length and bytes of a new
+ * name. The top-level nodes and the entries of objects, arrays and pointers are each terminated by an End tag.
+ * Array entries don't have names.
+ */
+namespace pl::gen::fmt::bin {
+
+    constexpr static std::array<u8, 4> Magic = { 'P', 'L', 'B', 0x00 };
+    constexpr static u8 Version = 1;
+
+    enum Flags : u8 {
+        MetaInformation = 0x01
+    };
+
+    enum class Tag : u8 {
+        End         = 0x00,
+        Unsigned    = 0x01,     // Value
+        Signed      = 0x02,     // Zigzag encoded value
+        Float       = 0x03,     // IEEE 754 double, little endian
+        Boolean     = 0x04,     // Single byte, 0 or 1. Any other non-zero value is written as 1
+        String      = 0x05,     // Length, UTF-8 bytes
+        Enum        = 0x06,     // Value, reference to the name of the value
+        Object      = 0x07,     // Entries
+        Array       = 0x08,     // Entries
+        Pointer     = 0x09,     // Address, entries holding the pointed at pattern
+    };
+
+    template<typename Output>
+    void writeVarInt(Output &output, u128 value) {
+        std::array<u8, 19> buffer = { };
+        size_t size = 0;
+
+        do {
+            buffer[size] = u8(value & 0x7F);
+            value >>= 7;
+
+            if (value != 0)
+                buffer[size] |= 0x80;
+            size++;
+        } while (value != 0);
+
+        output.write({ reinterpret_cast<const char*>(buffer.data()), size });
+    }
+
+    template<typename Output>
+    void writeSignedVarInt(Output &output, i128 value) {
+        writeVarInt(output, (u128(value) << 1) ^ u128(value >> 127));
+    }
+
+    /**
+     * @brief Cursor over an encoded buffer. Reading past its end throws std::out_of_range
+     */
+    class InputCursor {
+    public:
+        explicit InputCursor(std::span<const u8> data) : m_data(data) { }
+
+        [[nodiscard]] u8 readByte() {
+            if (this->m_position >= this->m_data.size())
+                throw std::out_of_range("Unexpected end of binary result data");
+
+            return this->m_data[this->m_position++];
+        }
+
+        [[nodiscard]] std::span<const u8> readBytes(size_t size) {
+            if (size > this->m_data.size() - this->m_position)
+                throw std::out_of_range("Unexpected end of binary result data");
+
+            auto result = this->m_data.subspan(this->m_position, size);
+            this->m_position += size;
+
+            return result;
+        }
+
+        [[nodiscard]] u128 readVarInt() {
+            u128 result = 0;
+
+            for (u32 shift = 0; shift < 128; shift += 7) {
+                const auto byte = this->readByte();
+                result |= u128(byte & 0x7F) << shift;
+
+                if ((byte & 0x80) == 0)
+                    return result;
+            }
+
+            throw std::out_of_range("Invalid integer in binary result data");
+        }
+
+        [[nodiscard]] i128 readSignedVarInt() {
+            const auto value = this->readVarInt();
+
+            return i128(value >> 1) ^ -i128(value & 1);
+        }
+
+        [[nodiscard]] double readDouble() {
+            const auto bytes = this->readBytes(sizeof(double));
+
+            u64 bits = 0;
+            for (size_t i = 0; i < sizeof(bits); i++)
+                bits |= u64(bytes[i]) << (i * 8);
+
+            double result;
+            std::memcpy(&result, &bits, sizeof(result));
+
+            return result;
+        }
+
+        [[nodiscard]] bool isAtEnd() const {
+            return this->m_position >= this->m_data.size();
+        }
+
+    private:
+        std::span<const u8> m_data;
+        size_t m_position = 0;
+    };
+
+}
@@ -0,0 +1,223 @@
+#pragma once
+
+#include <pl/formatters/binary_format.hpp>
+
+#include <algorithm>
+#include <bit>
+#include <string_view>
+#include <variant>
+#include <vector>
+
+namespace pl::gen::fmt {
+
+    /**
+     * @brief Reads results exported by FormatterBinary
+     * @note Nodes are decoded while they're handed to a Visitor, so apart from the table of names nothing is kept in
+     * memory. Names and strings point into the data that was passed in, so it needs to outlive the reader. Malformed
+     * data throws std::out_of_range or std::runtime_error
+     */
+    class BinaryResultReader {
+    public:
+        struct Node {
+            bin::Tag tag;
+            std::string_view name;          // Empty for array entries
+
+            // Only set if the results were exported with meta information
+            std::string_view typeName, comment;
+            u64 offset = 0, size = 0;
+            u32 color = 0;
+            std::endian endian = std::endian::little;
+
+            // Unsigned for enums and the address of pointers, nothing for objects and arrays
+            std::variant<std::monostate, u128, i128, double, bool, std::string_view> value;
+            std::string_view valueName;     // Name of the value of enums
+
+            [[nodiscard]] bool hasEntries() const {
+                return this->tag == bin::Tag::Object || this->tag == bin::Tag::Array || this->tag == bin::Tag::Pointer;
+            }
+        };
+
+        /**
+         * @brief Receives the nodes in the order they were written, entries of a node follow right after it
+         */
+        class Visitor {
+        public:
+            virtual ~Visitor() = default;
+
+            /**
+             * @brief Called for every node
+             * @param node Node. The reference is valid during the call, for objects, arrays and pointers until leave() was called for them
+             * @return False to skip over the entries of the node
+             */
+            virtual bool enter(const Node &node) = 0;
+
+            /**
+             * @brief Called after the last entry of an object, array or pointer whose entries weren't skipped
+             * @param node Node that was passed to enter()
+             */
+            virtual void leave(const Node &node) { (void)node; }
+        };
+
+        struct TreeNode {
+            Node node;
+            std::vector<TreeNode> entries;
+        };
+
+        explicit BinaryResultReader(std::span<const u8> data) {
+            bin::InputCursor cursor(data);
+
+            const auto magic = cursor.readBytes(bin::Magic.size());
+            if (!std::equal(magic.begin(), magic.end(), bin::Magic.begin()))
+                throw std::runtime_error("Data doesn't contain binary results");
+
+            if (const auto version = cursor.readByte(); version != bin::Version)
+                throw std::runtime_error("Unsupported binary result version");
+
+            this->m_metaInformation = (cursor.readByte() & bin::Flags::MetaInformation) != 0;
+            this->m_nodes = data.subspan(bin::Magic.size() + 2);
+        }
+
+        /**
+         * @brief Decodes all nodes and passes them on to a visitor
+         * @param visitor Visitor
+         */
+        void visit(Visitor &visitor) const {
+            bin::InputCursor cursor(this->m_nodes);
+            std::vector<std::string_view> names;
+
+            this->readNodes(cursor, names, &visitor, 0);
+        }
+
+        /**
+         * @brief Decodes all nodes into a tree
+         * @note Holds all results in memory at once, use visit() for large results
+         * @return Top-level nodes
+         */
+        [[nodiscard]] std::vector<TreeNode> readTree() const {
+            class TreeBuilder : public Visitor {
+            public:
+                explicit TreeBuilder(std::vector<TreeNode> &nodes) : m_parents({ &nodes }) { }
+
+                bool enter(const Node &node) override {
+                    auto &treeNode = this->m_parents.back()->emplace_back(node);
+                    if (node.hasEntries())
+                        this->m_parents.push_back(&treeNode.entries);
+
+                    return true;
+                }
+
+                void leave(const Node &) override {
+                    this->m_parents.pop_back();
+                }
+
+            private:
+                std::vector<std::vector<TreeNode>*> m_parents;
+            };
+
+            std::vector<TreeNode> result;
+            TreeBuilder builder(result);
+            this->visit(builder);
+
+            return result;
+        }
+
+        [[nodiscard]] bool hasMetaInformation() const {
+            return this->m_metaInformation;
+        }
+
+    private:
+        constexpr static u32 MaximumDepth = 1024;
+
+        static std::string_view readName(bin::InputCursor &cursor, std::vector<std::string_view> &names) {
+            const auto index = cursor.readVarInt();
+            if (index == 0)
+                return { };
+            else if (index <= names.size())
+                return names[size_t(index - 1)];
+            else if (index != names.size() + 1)
+                throw std::runtime_error("Invalid name reference in binary results");
+
+            const auto bytes = cursor.readBytes(size_t(cursor.readVarInt()));
+            return names.emplace_back(reinterpret_cast<const char*>(bytes.data()), bytes.size());
+        }
+
+        // Skipped entries are still decoded without a visitor, as they may define names used by later nodes
+        void readNodes(bin::InputCursor &cursor, std::vector<std::string_view> &names, Visitor *visitor, u32 depth) const {
+            if (depth > MaximumDepth)
+                throw std::runtime_error("Binary results are nested too deeply");
+
+            while (true) {
+                const auto tag = bin::Tag(cursor.readByte());
+                if (tag == bin::Tag::End)
+                    break;
+
+                Node node;
+                node.tag  = tag;
+                node.name = readName(cursor, names);
+
+                if (this->m_metaInformation) {
+                    node.typeName = readName(cursor, names);
+                    node.offset   = u64(cursor.readVarInt());
+                    node.size     = u64(cursor.readVarInt());
+
+                    const auto color = cursor.readBytes(sizeof(u32));
+                    node.color = u32(color[0]) | u32(color[1]) << 8 | u32(color[2]) << 16 | u32(color[3]) << 24;
+
+                    node.endian  = cursor.readByte() == 0 ? std::endian::little : std::endian::big;
+                    node.comment = readName(cursor, names);
+                }
+
+                switch (tag) {
+                    case bin::Tag::Unsigned:
+                        node.value = cursor.readVarInt();
+                        break;
+                    case bin::Tag::Signed:
+                        node.value = cursor.readSignedVarInt();
+                        break;
+                    case bin::Tag::Float:
+                        node.value = cursor.readDouble();
+                        break;
+                    case bin::Tag::Boolean: {
+                        const auto byte = cursor.readByte();
+                        if (byte > 1)
+                            throw std::runtime_error("Invalid boolean in binary results");
+
+                        node.value = byte == 1;
+                        break;
+                    }
+                    case bin::Tag::String: {
+                        const auto bytes = cursor.readBytes(size_t(cursor.readVarInt()));
+                        node.value = std::string_view(reinterpret_cast<const char*>(bytes.data()), bytes.size());
+                        break;
+                    }
+                    case bin::Tag::Enum:
+                        node.value     = cursor.readVarInt();
+                        node.valueName = readName(cursor, names);
+                        break;
+                    case bin::Tag::Pointer:
+                        node.value = cursor.readVarInt();
+                        break;
+                    case bin::Tag::Object:
+                    case bin::Tag::Array:
+                        break;
+                    default:
+                        throw std::runtime_error("Invalid tag in binary results");
+                }
+
+                const bool visitEntries = visitor != nullptr && visitor->enter(node);
+
+                if (node.hasEntries()) {
+                    this->readNodes(cursor, names, visitEntries ? visitor : nullptr, depth + 1);
+
+                    if (visitEntries)
+                        visitor->leave(node);
+                }
+            }
+        }
+
+    private:
+        std::span<const u8> m_nodes;
+        bool m_metaInformation = false;
+    };
+
+}
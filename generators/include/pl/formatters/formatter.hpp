@@ -21,16 +21,109 @@
 #include <pl/patterns/pattern_wide_character.hpp>
 #include <pl/patterns/pattern_wide_string.hpp>
 
+#include <pl/helpers/parallel.hpp>
+
+#include <functional>
+#include <optional>
 #include <string>
+#include <string_view>
 #include <utility>
+#include <vector>
 
 namespace pl::gen::fmt {
 
+    /**
+     * @brief Collects formatter output in a fixed size buffer and hands it to a write function whenever the buffer is full
+     */
+    class BufferedOutput {
+    public:
+        using WriteFunction = std::function<void(const u8 *data, size_t size)>;
+
+        explicit BufferedOutput(WriteFunction writeFunction, size_t bufferSize = 64 * 1024)
+            : m_writeFunction(std::move(writeFunction)) {
+            this->m_buffer.reserve(bufferSize);
+        }
+
+        BufferedOutput(const BufferedOutput&) = delete;
+        BufferedOutput &operator=(const BufferedOutput&) = delete;
+
+        ~BufferedOutput() {
+            this->flush();
+        }
+
+        void write(std::string_view string) {
+            while (!string.empty()) {
+                if (this->m_buffer.size() == this->m_buffer.capacity())
+                    this->flush();
+
+                const auto size = std::min(string.size(), this->m_buffer.capacity() - this->m_buffer.size());
+                this->m_buffer.insert(this->m_buffer.end(), string.begin(), string.begin() + size);
+                string.remove_prefix(size);
+            }
+        }
+
+        void write(char character, size_t count = 1) {
+            for (size_t i = 0; i < count; i++) {
+                if (this->m_buffer.size() == this->m_buffer.capacity())
+                    this->flush();
+
+                this->m_buffer.push_back(u8(character));
+            }
+        }
+
+        void flush() {
+            if (this->m_buffer.empty())
+                return;
+
+            this->m_writeFunction(this->m_buffer.data(), this->m_buffer.size());
+            this->m_buffer.clear();
+        }
+
+    private:
+        WriteFunction m_writeFunction;
+        std::vector<u8> m_buffer;
+    };
+
+    /**
+     * @brief Formats consecutive ranges of items on all threads and hands the results to a write function in order
+     * @note Only a limited number of ranges are kept in memory at once, so the output can still be streamed
+     * @param count Number of items
+     * @param formatRange Function formatting the items in [start, end) and returning the result
+     * @param writeResult Function called with the result of each range, in order
+     */
+    template<typename FormatRange, typename WriteResult>
+    void formatInParallel(size_t count, FormatRange &&formatRange, WriteResult &&writeResult) {
+        using Result = std::invoke_result_t<FormatRange, size_t, size_t>;
+
+        // Enough ranges per thread to balance out items that take longer to format than others
+        const size_t threadCount = std::max(1U, std::thread::hardware_concurrency());
+        const size_t rangeSize   = std::max<size_t>(1, count / (threadCount * 8));
+        const size_t batchSize   = threadCount * 4;
+
+        std::vector<std::optional<Result>> results;
+        for (size_t batchStart = 0; batchStart < count; batchStart += batchSize * rangeSize) {
+            const auto rangeCount = std::min(batchSize, (count - batchStart + rangeSize - 1) / rangeSize);
+
+            results.clear();
+            results.resize(rangeCount);
+            hlp::parallelFor(rangeCount, [&](size_t index) {
+                const auto start = batchStart + index * rangeSize;
+                results[index] = formatRange(start, std::min(start + rangeSize, count));
+            });
+
+            for (auto &result : results)
+                writeResult(std::move(*result));
+        }
+    }
+
     class FormatterPatternVisitor : public pl::PatternVisitor {
     public:
         void enableMetaInformation(bool enable) { this->m_metaInformation = enable; }
         [[nodiscard]] bool isMetaInformationEnabled() const { return this->m_metaInformation; }
 
+        void enableParallelFormatting(bool enable) { this->m_parallelFormatting = enable; }
+        [[nodiscard]] bool isParallelFormattingEnabled() const { return this->m_parallelFormatting; }
+
         std::vector<std::pair<std::string, std::string>> getMetaInformation(ptrn::Pattern *pattern) const {
             if (!this->m_metaInformation)
                 return { };
@@ -48,8 +141,39 @@ namespace pl::gen::fmt {
             return result;
         }
 
+    protected:
+        // Arrays with fewer entries aren't worth splitting up between threads
+        constexpr static u64 MinimumParallelEntryCount = 1024;
+
+        /**
+         * @brief Checks if the entries of an array should be split up between multiple threads
+         * @return True if the entries should be formatted in parallel
+         */
+        template<typename T>
+        [[nodiscard]] bool beginParallelIteration(T *pattern) const {
+            if constexpr (std::same_as<T, ptrn::PatternArrayStatic> || std::same_as<T, ptrn::PatternArrayDynamic>) {
+                return this->m_parallelFormatting && pattern->getEntryCount() >= MinimumParallelEntryCount;
+            } else {
+                wolv::util::unused(pattern);
+                return false;
+            }
+        }
+
+        /**
+         * @brief Calls a function for each entry in a range of an array
+         * @note Static arrays are iterated using a copy of their template so different ranges can be formatted on multiple threads at once
+         */
+        template<typename T>
+        static void forEachEntryInRange(T *pattern, u64 start, u64 end, const std::function<void(u64, ptrn::Pattern*)> &fn) {
+            if constexpr (std::same_as<T, ptrn::PatternArrayStatic>)
+                pattern->forEachEntryCopy(start, end, fn);
+            else
+                pattern->forEachEntry(start, end, fn);
+        }
+
     private:
         bool m_metaInformation = false;
+        bool m_parallelFormatting = false;
     };
 
     class Formatter {
@@ -64,12 +188,55 @@ namespace pl::gen::fmt {
         [[nodiscard]] virtual std::string getFileExtension() const = 0;
         [[nodiscard]] virtual std::vector<u8> format(const PatternLanguage &runtime) = 0;
 
+        /**
+         * @brief Formats the results directly into an output instead of building them in memory first
+         * @note Formatters that don't support streaming write the result of format() to the output
+         * @param runtime Runtime holding the results to format
+         * @param output Output to write to
+         */
+        virtual void format(const PatternLanguage &runtime, BufferedOutput &output) {
+            const auto result = this->format(runtime);
+            output.write({ reinterpret_cast<const char*>(result.data()), result.size() });
+        }
+
         void enableMetaInformation(bool enable) { this->m_metaInformation = enable; }
         [[nodiscard]] bool isMetaInformationEnabled() const { return this->m_metaInformation; }
 
+        /**
+         * @brief Formats independent top-level patterns and large arrays on multiple threads
+         * @note Formatter functions are still executed one at a time. The output is the same as without parallel formatting
+         */
+        void enableParallelFormatting(bool enable) { this->m_parallelFormatting = enable; }
+        [[nodiscard]] bool isParallelFormattingEnabled() const { return this->m_parallelFormatting; }
+
     private:
         std::string m_name;
         bool m_metaInformation = false;
+        bool m_parallelFormatting = false;
+    };
+
+    /**
+     * @brief Formatter that writes its results straight to an output and only builds them in memory if asked to
+     */
+    class StreamingFormatter : public Formatter {
+    public:
+        using Formatter::Formatter;
+
+        [[nodiscard]] std::vector<u8> format(const PatternLanguage &runtime) final {
+            std::vector<u8> result;
+
+            {
+                BufferedOutput output([&](const u8 *data, size_t size) {
+                    result.insert(result.end(), data, data + size);
+                });
+
+                this->format(runtime, output);
+            }
+
+            return result;
+        }
+
+        void format(const PatternLanguage &runtime, BufferedOutput &output) override = 0;
     };
 
 }
\ No newline at end of file
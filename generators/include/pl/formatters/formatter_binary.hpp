@@ -0,0 +1,193 @@
+#include <pl/formatters/formatter.hpp>
+#include <pl/formatters/binary_format.hpp>
+
+#include <unordered_map>
+
+namespace pl::gen::fmt {
+
+    class BinaryPatternVisitor : public FormatterPatternVisitor {
+    public:
+        explicit BinaryPatternVisitor(BufferedOutput &output) : m_output(output) { }
+
+        void visit(pl::ptrn::PatternArrayDynamic& pattern)  override { formatArray(&pattern);       }
+        void visit(pl::ptrn::PatternArrayStatic& pattern)   override { formatArray(&pattern);       }
+        void visit(pl::ptrn::PatternBitfieldField& pattern) override { formatValue(&pattern);       }
+        void visit(pl::ptrn::PatternBitfieldArray& pattern) override { formatArray(&pattern);       }
+        void visit(pl::ptrn::PatternBitfield& pattern)      override { formatObject(&pattern);      }
+        void visit(pl::ptrn::PatternBoolean& pattern)       override { formatValue(&pattern);       }
+        void visit(pl::ptrn::PatternCharacter& pattern)     override { formatValue(&pattern);       }
+        void visit(pl::ptrn::PatternEnum& pattern)          override { formatEnum(&pattern);        }
+        void visit(pl::ptrn::PatternFloat& pattern)         override { formatValue(&pattern);       }
+        void visit(pl::ptrn::PatternPadding& pattern)       override { wolv::util::unused(pattern); }
+        void visit(pl::ptrn::PatternPointer& pattern)       override { formatPointer(&pattern);     }
+        void visit(pl::ptrn::PatternSigned& pattern)        override { formatValue(&pattern);       }
+        void visit(pl::ptrn::PatternString& pattern)        override { formatString(&pattern);      }
+        void visit(pl::ptrn::PatternStruct& pattern)        override { formatObject(&pattern);      }
+        void visit(pl::ptrn::PatternUnion& pattern)         override { formatObject(&pattern);      }
+        void visit(pl::ptrn::PatternUnsigned& pattern)      override { formatValue(&pattern);       }
+        void visit(pl::ptrn::PatternWideCharacter& pattern) override { formatString(&pattern);      }
+        void visit(pl::ptrn::PatternWideString& pattern)    override { formatString(&pattern);      }
+
+        void writeEnd() {
+            this->writeTag(bin::Tag::End);
+        }
+
+    private:
+        void writeTag(bin::Tag tag) {
+            this->m_output.write(char(tag));
+        }
+
+        void writeName(const std::string &name) {
+            if (name.empty()) {
+                bin::writeVarInt(this->m_output, 0);
+                return;
+            }
+
+            if (auto it = this->m_names.find(name); it != this->m_names.end()) {
+                bin::writeVarInt(this->m_output, it->second);
+                return;
+            }
+
+            // The first use of a name defines it
+            const auto index = this->m_names.size() + 1;
+            this->m_names.emplace(name, index);
+
+            bin::writeVarInt(this->m_output, index);
+            bin::writeVarInt(this->m_output, name.size());
+            this->m_output.write(name);
+        }
+
+        void writeHeader(bin::Tag tag, ptrn::Pattern *pattern) {
+            this->writeTag(tag);
+
+            if (this->m_inArray)
+                bin::writeVarInt(this->m_output, 0);
+            else
+                this->writeName(pattern->getVariableName());
+
+            this->m_inArray = false;
+
+            if (this->isMetaInformationEnabled()) {
+                this->writeName(pattern->getTypeName());
+                bin::writeVarInt(this->m_output, pattern->getOffset());
+                bin::writeVarInt(this->m_output, pattern->getSize());
+
+                const auto color = pattern->getColor();
+                for (u32 i = 0; i < sizeof(color); i++)
+                    this->m_output.write(char((color >> (i * 8)) & 0xFF));
+
+                this->m_output.write(char(pattern->getEndian() == std::endian::little ? 0 : 1));
+                this->writeName(pattern->getComment());
+            }
+        }
+
+        void formatString(pl::ptrn::Pattern *pattern) {
+            const auto value = pattern->toString();
+
+            this->writeHeader(bin::Tag::String, pattern);
+            bin::writeVarInt(this->m_output, value.size());
+            this->m_output.write(value);
+        }
+
+        void formatEnum(pl::ptrn::PatternEnum *pattern) {
+            this->writeHeader(bin::Tag::Enum, pattern);
+            bin::writeVarInt(this->m_output, pattern->getValue().toUnsigned());
+            this->writeName(pattern->toString());
+        }
+
+        template<typename T>
+        void formatArray(T *pattern) {
+            this->writeHeader(bin::Tag::Array, pattern);
+            pattern->forEachEntry(0, pattern->getEntryCount(), [&](u64, auto member) {
+                this->m_inArray = true;
+                member->accept(*this);
+            });
+            this->m_inArray = false;
+            this->writeEnd();
+        }
+
+        void formatPointer(ptrn::PatternPointer *pattern) {
+            this->writeHeader(bin::Tag::Pointer, pattern);
+            bin::writeVarInt(this->m_output, u64(pattern->getPointedAtAddress()));
+            pattern->getPointedAtPattern()->accept(*this);
+            this->writeEnd();
+        }
+
+        template<typename T>
+        void formatObject(T *pattern) {
+            if (pattern->isSealed()) {
+                formatValue(pattern);
+            } else {
+                this->writeHeader(bin::Tag::Object, pattern);
+                pattern->forEachEntry(0, pattern->getEntryCount(), [&](u64, auto member) {
+                    member->accept(*this);
+                });
+                this->writeEnd();
+            }
+        }
+
+        void formatValue(pl::ptrn::Pattern *pattern) {
+            if (auto functionName = pattern->getReadFormatterFunction(); !functionName.empty()) {
+                formatString(pattern);
+                return;
+            }
+
+            std::visit(wolv::util::overloaded {
+                [&](u128 value) {
+                    this->writeHeader(bin::Tag::Unsigned, pattern);
+                    bin::writeVarInt(this->m_output, value);
+                },
+                [&](i128 value) {
+                    this->writeHeader(bin::Tag::Signed, pattern);
+                    bin::writeSignedVarInt(this->m_output, value);
+                },
+                [&](double value) {
+                    u64 bits;
+                    std::memcpy(&bits, &value, sizeof(bits));
+
+                    this->writeHeader(bin::Tag::Float, pattern);
+                    for (u32 i = 0; i < sizeof(bits); i++)
+                        this->m_output.write(char((bits >> (i * 8)) & 0xFF));
+                },
+                [&](bool value) {
+                    this->writeHeader(bin::Tag::Boolean, pattern);
+                    this->m_output.write(char(value ? 1 : 0));
+                },
+                [&](const auto &) {
+                    formatString(pattern);
+                }
+            }, pattern->getValue());
+        }
+
+    private:
+        BufferedOutput &m_output;
+        std::unordered_map<std::string, u64> m_names;
+        bool m_inArray = false;
+    };
+
+    class FormatterBinary : public StreamingFormatter {
+    public:
+        FormatterBinary() : StreamingFormatter("binary") { }
+        ~FormatterBinary() override = default;
+
+        using StreamingFormatter::format;
+
+        [[nodiscard]] std::string getFileExtension() const override { return ".plb"; }
+
+        void format(const PatternLanguage &runtime, BufferedOutput &output) override {
+            BinaryPatternVisitor visitor(output);
+            visitor.enableMetaInformation(this->isMetaInformationEnabled());
+
+            output.write({ reinterpret_cast<const char*>(bin::Magic.data()), bin::Magic.size() });
+            output.write(char(bin::Version));
+            output.write(char(this->isMetaInformationEnabled() ? bin::Flags::MetaInformation : 0x00));
+
+            for (const auto& pattern : runtime.getAllPatterns()) {
+                pattern->accept(visitor);
+            }
+
+            visitor.writeEnd();
+        }
+    };
+
+}
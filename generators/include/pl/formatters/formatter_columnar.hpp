@@ -0,0 +1,335 @@
+#pragma once
+
+#include <pl/formatters/formatter.hpp>
+#include <pl/helpers/utils.hpp>
+
+#include <array>
+#include <bit>
+#include <cstring>
+
+/**
+ * Layout of the columnar format written by FormatterColumnar
+ *
+ * Header:  Magic "PLC\0", version (u32), table count (u32), reserved (u32)
+ * Table:   Row count (u64), column count (u32), name length (u32), name bytes, followed by its columns
+ * Column:  Data offset (u64), type (u8, see ColumnType), width (u8), reserved (u16), name length (u32), name bytes
+ *
+ * All integers are little endian. Every column holds row count values of width bytes each, stored as little endian
+ * native values starting at its data offset, which is relative to the start of the output and aligned to 8 bytes.
+ * Signed values are sign extended to the width of their column, enums are stored as their underlying value.
+ */
+namespace pl::gen::fmt {
+
+    namespace col {
+
+        constexpr static std::array<u8, 4> Magic = { 'P', 'L', 'C', 0x00 };
+        constexpr static u32 Version = 1;
+
+        enum class ColumnType : u8 {
+            Unsigned    = 0x00,
+            Signed      = 0x01,
+            Float       = 0x02,     // IEEE 754, width 4 or 8
+            Boolean     = 0x03,
+            Character   = 0x04,
+            Enum        = 0x05
+        };
+
+    }
+
+    /**
+     * @brief Exports arrays of structs and scalars as one contiguous, typed column per field
+     * @note Only arrays whose entries all share the same layout are exported. Strings, pointers, bitfields, unions
+     * and nested arrays don't have a fixed width representation and are left out
+     */
+    class FormatterColumnar : public StreamingFormatter {
+    public:
+        FormatterColumnar() : StreamingFormatter("columnar") { }
+        ~FormatterColumnar() override = default;
+
+        using StreamingFormatter::format;
+
+        [[nodiscard]] std::string getFileExtension() const override { return ".plc"; }
+
+        void format(const PatternLanguage &runtime, BufferedOutput &output) override {
+            std::vector<Table> tables;
+            for (const auto &pattern : runtime.getAllPatterns())
+                collectTables(pattern.get(), "", tables);
+
+            // Column data is placed right after the schema, so its size needs to be known up front
+            const auto schemaSize = getSchemaSize(tables);
+
+            u64 offset = schemaSize;
+            output.write({ reinterpret_cast<const char*>(col::Magic.data()), col::Magic.size() });
+            writeInteger(output, col::Version, sizeof(u32));
+            writeInteger(output, u32(tables.size()), sizeof(u32));
+            writeInteger(output, u32(0), sizeof(u32));
+
+            for (const auto &table : tables) {
+                writeInteger(output, table.rowCount, sizeof(u64));
+                writeInteger(output, u32(table.columns.size()), sizeof(u32));
+                writeInteger(output, u32(table.name.size()), sizeof(u32));
+                output.write(table.name);
+
+                for (const auto &column : table.columns) {
+                    offset = alignTo(offset, DataAlignment);
+
+                    writeInteger(output, offset, sizeof(u64));
+                    output.write(char(column.type));
+                    output.write(char(column.width));
+                    writeInteger(output, u16(0), sizeof(u16));
+                    writeInteger(output, u32(column.name.size()), sizeof(u32));
+                    output.write(column.name);
+
+                    offset += table.rowCount * column.width;
+                }
+            }
+
+            u64 position = schemaSize;
+            for (const auto &table : tables) {
+                for (const auto &column : table.columns) {
+                    const auto aligned = alignTo(position, DataAlignment);
+                    output.write('\x00', aligned - position);
+
+                    writeColumn(output, table, column);
+                    position = aligned + table.rowCount * column.width;
+                }
+            }
+        }
+
+    private:
+        constexpr static u64 HeaderSize         = 16;
+        constexpr static u64 TableHeaderSize    = 16;
+        constexpr static u64 ColumnHeaderSize   = 16;
+        constexpr static u64 DataAlignment      = 8;
+        constexpr static u64 ChunkSize          = 1024 * 1024;
+
+        struct Column {
+            std::string name;
+            col::ColumnType type;
+            u64 offset, size;
+            u8 width;
+            std::endian endian;
+
+            bool operator==(const Column &) const = default;
+        };
+
+        struct Table {
+            std::string name;
+            std::vector<Column> columns;
+
+            core::Evaluator *evaluator;
+            u64 section;
+            u64 address, stride, rowCount;
+
+            // Start address of every row if the entries aren't laid out back to back
+            std::vector<u64> rowAddresses;
+        };
+
+        [[nodiscard]] constexpr static u64 alignTo(u64 value, u64 alignment) {
+            return (value + alignment - 1) / alignment * alignment;
+        }
+
+        [[nodiscard]] static u64 getSchemaSize(const std::vector<Table> &tables) {
+            u64 size = HeaderSize;
+            for (const auto &table : tables) {
+                size += TableHeaderSize + table.name.size();
+                for (const auto &column : table.columns)
+                    size += ColumnHeaderSize + column.name.size();
+            }
+
+            return size;
+        }
+
+        template<typename T>
+        static void writeInteger(BufferedOutput &output, T value, size_t size) {
+            for (size_t i = 0; i < size; i++)
+                output.write(char((u64(value) >> (i * 8)) & 0xFF));
+        }
+
+        static void collectTables(ptrn::Pattern *pattern, const std::string &prefix, std::vector<Table> &tables) {
+            if (pattern->isLocal() || pattern->isPatternLocal())
+                return;
+
+            const auto name = prefix + pattern->getVariableName();
+
+            if (auto staticArray = dynamic_cast<ptrn::PatternArrayStatic*>(pattern); staticArray != nullptr) {
+                // The template describes every entry, so the entries themselves never need to be created
+                const auto &entry = staticArray->getTemplate();
+                if (entry == nullptr || entry->getSize() == 0)
+                    return;
+
+                Table table = { name, { }, pattern->getEvaluator(), pattern->getSection(), pattern->getOffset(), entry->getSize(), staticArray->getEntryCount(), { } };
+                collectEntryColumns(entry.get(), table.columns);
+
+                if (!table.columns.empty())
+                    tables.push_back(std::move(table));
+            } else if (auto dynamicArray = dynamic_cast<ptrn::PatternArrayDynamic*>(pattern); dynamicArray != nullptr) {
+                const auto entries = dynamicArray->getEntries();
+                if (entries.empty() || entries.front()->getSize() == 0)
+                    return;
+
+                const auto &first = entries.front();
+                Table table = { name, { }, pattern->getEvaluator(), pattern->getSection(), first->getOffset(), first->getSize(), entries.size(), { } };
+                collectEntryColumns(first.get(), table.columns);
+                if (table.columns.empty())
+                    return;
+
+                // Every entry needs to have the same layout. Names don't change between entries, so they aren't built for the check
+                std::vector<Column> layout, columns;
+                collectEntryColumns(first.get(), layout, false);
+
+                bool contiguous = true;
+                for (u64 i = 1; i < entries.size(); i++) {
+                    const auto &entry = entries[i];
+                    if (entry->getSize() != table.stride)
+                        return;
+
+                    columns.clear();
+                    collectEntryColumns(entry.get(), columns, false);
+                    if (columns != layout)
+                        return;
+
+                    if (entry->getOffset() != table.address + i * table.stride)
+                        contiguous = false;
+                }
+
+                if (!contiguous) {
+                    table.rowAddresses.reserve(entries.size());
+                    for (const auto &entry : entries)
+                        table.rowAddresses.push_back(entry->getOffset());
+                }
+
+                tables.push_back(std::move(table));
+            } else if (auto structPattern = dynamic_cast<ptrn::PatternStruct*>(pattern); structPattern != nullptr && !structPattern->isSealed()) {
+                structPattern->forEachEntry(0, structPattern->getEntryCount(), [&](u64, ptrn::Pattern *member) {
+                    collectTables(member, name + ".", tables);
+                });
+            }
+        }
+
+        static void collectColumns(ptrn::Pattern *pattern, u64 base, u64 entrySize, const std::string &prefix, std::vector<Column> &columns, bool named) {
+            if (pattern->isLocal() || pattern->isPatternLocal())
+                return;
+
+            const auto name = named ? prefix + pattern->getVariableName() : std::string();
+
+            if (auto structPattern = dynamic_cast<ptrn::PatternStruct*>(pattern); structPattern != nullptr) {
+                if (!structPattern->isSealed()) {
+                    structPattern->forEachEntry(0, structPattern->getEntryCount(), [&](u64, ptrn::Pattern *member) {
+                        collectColumns(member, base, entrySize, named ? name + "." : name, columns, named);
+                    });
+                }
+
+                return;
+            }
+
+            addColumn(pattern, name, base, entrySize, columns);
+        }
+
+        static void collectEntryColumns(ptrn::Pattern *entry, std::vector<Column> &columns, bool named = true) {
+            const auto base = entry->getOffset(), size = entry->getSize();
+
+            if (auto structPattern = dynamic_cast<ptrn::PatternStruct*>(entry); structPattern != nullptr) {
+                if (!structPattern->isSealed()) {
+                    structPattern->forEachEntry(0, structPattern->getEntryCount(), [&](u64, ptrn::Pattern *member) {
+                        collectColumns(member, base, size, "", columns, named);
+                    });
+                }
+            } else {
+                // Entries of scalar arrays consist of a single unnamed value
+                addColumn(entry, named ? "value" : "", base, size, columns);
+            }
+        }
+
+        static void addColumn(ptrn::Pattern *pattern, const std::string &name, u64 base, u64 entrySize, std::vector<Column> &columns) {
+            col::ColumnType type;
+            if (dynamic_cast<ptrn::PatternUnsigned*>(pattern) != nullptr)
+                type = col::ColumnType::Unsigned;
+            else if (dynamic_cast<ptrn::PatternSigned*>(pattern) != nullptr)
+                type = col::ColumnType::Signed;
+            else if (dynamic_cast<ptrn::PatternFloat*>(pattern) != nullptr)
+                type = col::ColumnType::Float;
+            else if (dynamic_cast<ptrn::PatternBoolean*>(pattern) != nullptr)
+                type = col::ColumnType::Boolean;
+            else if (dynamic_cast<ptrn::PatternCharacter*>(pattern) != nullptr)
+                type = col::ColumnType::Character;
+            else if (dynamic_cast<ptrn::PatternEnum*>(pattern) != nullptr)
+                type = col::ColumnType::Enum;
+            else
+                return;
+
+            const auto size = pattern->getSize();
+            if (size == 0 || size > sizeof(u64) || pattern->getOffset() < base || pattern->getOffset() - base + size > entrySize)
+                return;
+            if (type == col::ColumnType::Float && size != sizeof(float) && size != sizeof(double))
+                return;
+
+            columns.push_back({ name, type, pattern->getOffset() - base, size, u8(std::bit_ceil(size)), pattern->getEndian() });
+        }
+
+        static void writeValue(std::vector<u8> &buffer, const u8 *data, const Column &column) {
+            u64 value = 0;
+            std::memcpy(&value, data, column.size);
+            value = hlp::changeEndianess(value, column.size, column.endian);
+
+            if (column.type == col::ColumnType::Signed && column.size < sizeof(u64) && (value >> (column.size * 8 - 1)) & 1)
+                value |= ~u64(0) << (column.size * 8);
+
+            value = hlp::changeEndianess(value, std::endian::little);
+
+            const auto bytes = reinterpret_cast<const u8*>(&value);
+            buffer.insert(buffer.end(), bytes, bytes + column.width);
+        }
+
+        static void writeColumn(BufferedOutput &output, const Table &table, const Column &column) {
+            std::vector<u8> values;
+
+            if (!table.rowAddresses.empty()) {
+                std::array<u8, sizeof(u64)> data = { };
+
+                values.reserve(std::min<u64>(table.rowCount, ChunkSize) * column.width);
+                for (const auto address : table.rowAddresses) {
+                    table.evaluator->readData(address + column.offset, data.data(), column.size, table.section);
+                    writeValue(values, data.data(), column);
+
+                    if (values.size() >= ChunkSize * column.width) {
+                        output.write({ reinterpret_cast<const char*>(values.data()), values.size() });
+                        values.clear();
+                    }
+                }
+            } else {
+                // Read whole runs of rows at once and pick the column out of them
+                const auto rowsPerChunk = std::max<u64>(1, ChunkSize / table.stride);
+                std::vector<u8> data;
+
+                for (u64 row = 0; row < table.rowCount; row += rowsPerChunk) {
+                    const auto rows = std::min(rowsPerChunk, table.rowCount - row);
+                    const auto readSize = (rows - 1) * table.stride + column.size;
+
+                    data.resize(readSize);
+                    table.evaluator->readData(table.address + row * table.stride + column.offset, data.data(), readSize, table.section);
+
+                    if (column.size == column.width) {
+                        // Values that don't need to be sign extended are gathered as they are and byte swapped all at once
+                        values.resize(rows * column.width);
+                        for (u64 i = 0; i < rows; i++)
+                            std::memcpy(&values[i * column.width], data.data() + i * table.stride, column.width);
+
+                        if (column.endian != std::endian::little)
+                            hlp::swapByteOrder(values.data(), column.width, rows);
+                    } else {
+                        for (u64 i = 0; i < rows; i++)
+                            writeValue(values, data.data() + i * table.stride, column);
+                    }
+
+                    output.write({ reinterpret_cast<const char*>(values.data()), values.size() });
+                    values.clear();
+                }
+            }
+
+            if (!values.empty())
+                output.write({ reinterpret_cast<const char*>(values.data()), values.size() });
+        }
+    };
+
+}
@@ -1,148 +1,295 @@
+#pragma once
+
 #include <pl/formatters/formatter.hpp>
+#include <pl/helpers/parallel.hpp>
+
+#include <iterator>
+#include <map>
 
 namespace pl::gen::fmt {
 
-    class FormatterHtml : public Formatter {
+    class FormatterHtml : public StreamingFormatter {
     public:
-        FormatterHtml() : Formatter("html") { }
+        FormatterHtml() : StreamingFormatter("html") { }
         ~FormatterHtml() override = default;
 
+        using StreamingFormatter::format;
+
         [[nodiscard]] std::string getFileExtension() const override { return ".html"; }
 
-        [[nodiscard]] std::vector<u8> format(const PatternLanguage &runtime) override {
-            auto result = generateHtml(runtime);
+        void format(const PatternLanguage &runtime, BufferedOutput &output) override {
+            const auto [startAddress, endAddress] = getDataRange(runtime);
 
-            return { result.begin(), result.end() };
+            writeHeader(output);
+            writeRows(runtime, startAddress, endAddress, output);
+            writeFooter(output);
         }
 
-    private:
-        static std::string generateTooltip(const std::vector<ptrn::Pattern*> &patterns) {
-            if (patterns.empty())
-                return "";
+        /**
+         * @brief Sets the number of bytes shown on each page written by formatPage()
+         * @note The size is rounded up to whole rows. Zero shows all data on a single page
+         * @param size Number of bytes per page
+         */
+        void setPageSize(u64 size) {
+            this->m_pageSize = (size + RowSize - 1) / RowSize * RowSize;
+        }
 
-            std::string content;
-            for (auto *pattern : patterns) {
-                content += ::fmt::format(R"html({} {} | {}<br>)html", pattern->getFormattedName(), pattern->getVariableName(), pattern->toString());
-            }
+        [[nodiscard]] u64 getPageSize() const {
+            return this->m_pageSize;
+        }
 
-            if (!content.empty())
-                content.resize(content.size() - 4);
+        [[nodiscard]] u64 getPageCount(const PatternLanguage &runtime) const {
+            const auto [startAddress, endAddress] = getDataRange(runtime);
+            if (this->m_pageSize == 0 || endAddress <= startAddress)
+                return 1;
 
-            return ::fmt::format(R"html(<br><span class="pattern_language_tooltip" style="background-color: #{:08X}"><div class="pattern_language_tooltip_text">{}</div></span>)html", (hlp::changeEndianess(patterns.front()->getColor(), std::endian::big) | 0x000000FF) & 0xAFAFAFFF, content);
+            return (endAddress - startAddress + this->m_pageSize - 1) / this->m_pageSize;
         }
 
-        static std::string generateCell(u64 address, const PatternLanguage &runtime) {
-            auto patterns = runtime.getPatternsAtAddress(address);
+        /**
+         * @brief Formats a single page of the data as a standalone document with links to its neighbouring pages
+         * @param runtime Runtime holding the results to format
+         * @param page Index of the page
+         * @param output Output to write to
+         * @param getPageLink Function returning the link to the page with the given index
+         */
+        void formatPage(const PatternLanguage &runtime, u64 page, BufferedOutput &output, const std::function<std::string(u64)> &getPageLink) {
+            const auto [startAddress, endAddress] = getDataRange(runtime);
+            const auto pageCount = this->getPageCount(runtime);
+
+            auto pageStart = startAddress, pageEnd = endAddress;
+            if (this->m_pageSize != 0) {
+                pageStart = std::min(startAddress + page * this->m_pageSize, endAddress);
+                pageEnd   = std::min(pageStart + this->m_pageSize, endAddress);
+            }
+
+            std::string navigation = R"html(    <div class="pattern_language_navigation">)html";
+            if (page > 0)
+                navigation += ::fmt::format(R"html(<a href="{}">&lt; Previous</a> )html", getPageLink(page - 1));
+            navigation += ::fmt::format("Page {} / {}", page + 1, pageCount);
+            if (page + 1 < pageCount)
+                navigation += ::fmt::format(R"html( <a href="{}">Next &gt;</a>)html", getPageLink(page + 1));
+            navigation += "</div>\n";
+
+            writeHeader(output, navigation);
+            writeRows(runtime, pageStart, pageEnd, output);
+            writeFooter(output);
+        }
+
+    private:
+        constexpr static u64 RowSize    = 0x10;
+        constexpr static u64 BlockSize  = 0x1000;
+
+        using TitleCache = std::map<std::pair<const ptrn::Pattern*, u64>, std::string>;
+
+        [[nodiscard]] static std::pair<u64, u64> getDataRange(const PatternLanguage &runtime) {
+            auto evaluator = runtime.getInternals().evaluator;
 
-            u8 byte = 0;
-            runtime.getInternals().evaluator->readData(address, &byte, sizeof(byte), ptrn::Pattern::MainSectionId);
+            return { evaluator->getDataBaseAddress(), evaluator->getDataBaseAddress() + evaluator->getDataSize() };
+        }
 
-            return ::fmt::format(R"html(<div class="pattern_language_cell" style="background-color: #{}">{:02X}{}</div>)html",
-                                 patterns.empty() ? "transparent" : ::fmt::format("{:08X}", hlp::changeEndianess(patterns.front()->getColor(), std::endian::big)),
-                                 byte,
-                                 generateTooltip(patterns)
-                                 );
+        static void appendEscaped(std::string &result, std::string_view text) {
+            for (const char c : text) {
+                switch (c) {
+                    case '<':  result += "&lt;";   break;
+                    case '>':  result += "&gt;";   break;
+                    case '&':  result += "&amp;";  break;
+                    case '"':  result += "&quot;"; break;
+                    case '\n': result += ' ';      break;
+                    default:   result += c;        break;
+                }
+            }
         }
 
-        static std::string generateRow(u64 address, const PatternLanguage &runtime) {
+        static std::string formatTitleLine(const PatternLanguage::PatternSpan::Entry &entry) {
             std::string result;
+            appendEscaped(result, ::fmt::format("{} {} | {}", entry.pattern->getFormattedName(), entry.pattern->getVariableName(), entry.pattern->getFormattedValueAt(entry.offset)));
+
+            return result;
+        }
+
+        static void appendTitle(std::string &result, const std::vector<PatternLanguage::PatternSpan::Entry> &patterns, const TitleCache &sharedLines, TitleCache &lineCache) {
+            bool first = true;
+            for (const auto &entry : patterns) {
+                if (!first)
+                    result += "&#10;";
+                first = false;
 
-            result += R"html(<div class="pattern_language_row">)html";
-            result += ::fmt::format(R"html(<div class="pattern_language_address">{:08X}</div>)html", address);
+                if (auto it = sharedLines.find({ entry.pattern, entry.offset }); it != sharedLines.end()) {
+                    result += it->second;
+                    continue;
+                }
 
-            for (u64 i = address; i < runtime.getInternals().evaluator->getDataSize() && i < address + 0x10; i++) {
-                result += generateCell(i, runtime);
+                // Patterns that contain the run show up in the title of every run inside of them
+                auto [it, inserted] = lineCache.try_emplace({ entry.pattern, entry.offset });
+                if (inserted)
+                    it->second = formatTitleLine(entry);
 
-                if ((i & 0x0F) == 0x07)
-                    result += R"html(<div class="pattern_language_cell">&nbsp;</div>)html";
+                result += it->second;
             }
+        }
 
-            result += R"html(</div><br>)html";
+        /**
+         * @brief Formats the title lines of all patterns that extend over more than one block
+         * @note Blocks are formatted independently of each other, so without this every block would format these patterns again
+         */
+        [[nodiscard]] TitleCache formatSharedTitleLines(const PatternLanguage &runtime, u64 start, u64 end) const {
+            TitleCache result;
+            std::vector<PatternLanguage::PatternSpan::Entry> entries;
+
+            for (u64 boundary = start + BlockSize; boundary < end; boundary += BlockSize) {
+                for (const auto &entry : runtime.findPatternsAtAddress(boundary)) {
+                    if (entry.offset < boundary && result.try_emplace({ entry.pattern, entry.offset }).second)
+                        entries.push_back(entry);
+                }
+            }
+
+            std::vector<std::string> lines(entries.size());
+            const auto formatLine = [&](size_t index) { lines[index] = formatTitleLine(entries[index]); };
+            if (this->isParallelFormattingEnabled()) {
+                hlp::parallelFor(entries.size(), formatLine);
+            } else {
+                for (size_t i = 0; i < entries.size(); i++)
+                    formatLine(i);
+            }
+
+            for (size_t i = 0; i < entries.size(); i++)
+                result[{ entries[i].pattern, entries[i].offset }] = std::move(lines[i]);
 
             return result;
         }
 
-        static std::string generateHtml(const PatternLanguage &runtime) {
-            std::string rows;
+        static void appendBytes(std::string &result, const u8 *data, u64 address, u64 count) {
+            constexpr static auto HexDigits = "0123456789ABCDEF";
 
-            auto evaluator = runtime.getInternals().evaluator;
+            for (u64 i = 0; i < count; i++) {
+                if (i > 0)
+                    result += ((address + i) & 0x0F) == 0x08 ? "  " : " ";
 
-            for (u64 i = evaluator->getDataBaseAddress(); i < evaluator->getDataSize(); i += 0x10) {
-                rows += generateRow(i, runtime);
+                result += HexDigits[data[i] >> 4];
+                result += HexDigits[data[i] & 0x0F];
             }
+        }
+
+        /**
+         * @brief Formats the rows of a block of data in a single sweep over the patterns in it
+         * @note Consecutive bytes covered by the same patterns are written as a single run sharing one color and title
+         */
+        static std::string formatBlock(const PatternLanguage &runtime, u64 start, u64 end, const TitleCache &sharedLines) {
+            std::vector<u8> data(end - start);
+            runtime.getInternals().evaluator->readData(start, data.data(), data.size(), ptrn::Pattern::MainSectionId);
+
+            const auto spans = runtime.getPatternsInRange(start, end - 1);
+            auto span = spans.begin();
 
-            return R"html(
+            TitleCache lineCache;
+            std::string result;
+
+            for (u64 rowStart = start; rowStart < end; rowStart += RowSize) {
+                const auto rowEnd = std::min(rowStart + RowSize, end);
+
+                ::fmt::format_to(std::back_inserter(result), R"html(<div class="pattern_language_row"><span class="pattern_language_address">{:08X}</span> )html", rowStart);
+
+                for (u64 address = rowStart; address < rowEnd;) {
+                    while (span != spans.end() && span->end < address)
+                        ++span;
+
+                    const bool covered = span != spans.end() && span->start <= address;
+
+                    u64 runEnd = rowEnd;
+                    if (covered)
+                        runEnd = std::min(runEnd, span->end + 1);
+                    else if (span != spans.end())
+                        runEnd = std::min(runEnd, span->start);
+
+                    if (address != rowStart)
+                        result += (address & 0x0F) == 0x08 ? "  " : " ";
+
+                    if (covered) {
+                        ::fmt::format_to(std::back_inserter(result), R"html(<span style="background-color: #{:08X}" title=")html", hlp::changeEndianess(span->patterns.front().color, std::endian::big));
+                        appendTitle(result, span->patterns, sharedLines, lineCache);
+                        result += "\">";
+                        appendBytes(result, &data[address - start], address, runEnd - address);
+                        result += "</span>";
+                    } else {
+                        appendBytes(result, &data[address - start], address, runEnd - address);
+                    }
+
+                    address = runEnd;
+                }
+
+                result += "</div>\n";
+            }
+
+            return result;
+        }
+
+        void writeRows(const PatternLanguage &runtime, u64 start, u64 end, BufferedOutput &output) const {
+            if (start >= end)
+                return;
+
+            const auto blockCount = (end - start + BlockSize - 1) / BlockSize;
+            const auto getBlockEnd = [&](u64 block) { return std::min(start + (block + 1) * BlockSize, end); };
+            const auto sharedLines = this->formatSharedTitleLines(runtime, start, end);
+
+            if (this->isParallelFormattingEnabled()) {
+                formatInParallel(blockCount, [&](u64 first, u64 last) {
+                    std::string result;
+                    for (u64 block = first; block < last; block++)
+                        result += formatBlock(runtime, start + block * BlockSize, getBlockEnd(block), sharedLines);
+
+                    return result;
+                }, [&](std::string &&result) {
+                    output.write(result);
+                });
+            } else {
+                for (u64 block = 0; block < blockCount; block++)
+                    output.write(formatBlock(runtime, start + block * BlockSize, getBlockEnd(block), sharedLines));
+            }
+        }
+
+        static void writeHeader(BufferedOutput &output, std::string_view navigation = "") {
+            output.write(R"html(
 <div>
     <style type="text/css">
         .pattern_language_container {
             display: inline-block;
+            font-family: monospace;
         }
 
         .pattern_language_row {
             margin: 0px;
+            white-space: pre;
         }
 
         .pattern_language_address {
-            float: left;
             padding-right: 10px;
-            font-family: monospace;
-        }
-
-        .pattern_language_cell {
-            float: left;
-            padding-left: 1px;
-            padding-right: 1px;
-            font-family: monospace;
         }
 
-        .pattern_language_tooltip_text {
-            color: white;
-            text-align: center;
+        .pattern_language_row span[title]:hover {
+            outline: solid 1px darkgray;
         }
 
-        .pattern_language_tooltip {
-            visibility: hidden;
-            border: solid 1px darkgray;
-
-            padding: 5px 5px;
-
-            position: absolute;
-            z-index: 1;
-            pointer-events : none
+        .pattern_language_navigation {
+            margin-bottom: 10px;
         }
+    </style>
 
-        .pattern_language_cell:hover .pattern_language_tooltip {
-            visibility: visible;
+)html");
+            output.write(navigation);
+            output.write(R"html(    <div class="pattern_language_container">
+        <div class="pattern_language_row"><span class="pattern_language_address">        </span> 00 01 02 03 04 05 06 07  08 09 0A 0B 0C 0D 0E 0F</div>
+)html");
         }
-    </style>
 
-    <div class="pattern_language_container">
-        <div class="pattern_language_row">
-            <div class="pattern_language_address">&nbsp;&nbsp;&nbsp;&nbsp;&nbsp;&nbsp;&nbsp;&nbsp;</div>
-            <div class="pattern_language_cell">00</div>
-            <div class="pattern_language_cell">01</div>
-            <div class="pattern_language_cell">02</div>
-            <div class="pattern_language_cell">03</div>
-            <div class="pattern_language_cell">04</div>
-            <div class="pattern_language_cell">05</div>
-            <div class="pattern_language_cell">06</div>
-            <div class="pattern_language_cell">07</div>
-            <div class="pattern_language_cell">&nbsp;</div>
-            <div class="pattern_language_cell">08</div>
-            <div class="pattern_language_cell">09</div>
-            <div class="pattern_language_cell">0A</div>
-            <div class="pattern_language_cell">0B</div>
-            <div class="pattern_language_cell">0C</div>
-            <div class="pattern_language_cell">0D</div>
-            <div class="pattern_language_cell">0E</div>
-            <div class="pattern_language_cell">0F</div>
-        </div>
-        <br>
-        )html" + rows + R"html(
-    </div>
+        static void writeFooter(BufferedOutput &output) {
+            output.write(R"html(    </div>
 </div>
-            )html";
+)html");
         }
+
+    private:
+        u64 m_pageSize = 0;
     };
 
-}
\ No newline at end of file
+}
@@ -1,10 +1,12 @@
+#pragma once
+
 #include <pl/formatters/formatter.hpp>
 
 namespace pl::gen::fmt {
 
     class JsonPatternVisitor : public FormatterPatternVisitor {
     public:
-        JsonPatternVisitor() = default;
+        explicit JsonPatternVisitor(BufferedOutput &output) : m_output(output) { }
 
         void visit(pl::ptrn::PatternArrayDynamic& pattern)  override { formatArray(&pattern);       }
         void visit(pl::ptrn::PatternArrayStatic& pattern)   override { formatArray(&pattern);       }
@@ -25,10 +27,6 @@ namespace pl::gen::fmt {
         void visit(pl::ptrn::PatternWideCharacter& pattern) override { formatString(&pattern);      }
         void visit(pl::ptrn::PatternWideString& pattern)    override { formatString(&pattern);      }
 
-        [[nodiscard]] auto getResult() const {
-            return this->m_result;
-        }
-
         void pushIndent() {
             this->m_indent += 4;
         }
@@ -36,20 +34,75 @@ namespace pl::gen::fmt {
         void popIndent() {
             this->m_indent -= 4;
 
-            if (this->m_result.size() >= 2 && this->m_result.substr(this->m_result.size() - 2) == ",\n") {
-                this->m_result.pop_back();
-                this->m_result.pop_back();
-                this->m_result.push_back('\n');
+            // The last line of a block doesn't get a separating comma
+            if (this->m_commaPending) {
+                this->m_output.write('\n');
+                this->m_commaPending = false;
             }
         }
 
+        /**
+         * @brief Formats ranges of items on multiple threads, each with its own visitor, and writes the results in order
+         * @param count Number of items
+         * @param formatRange Function formatting the items in [start, end) using the visitor it's passed
+         */
+        void formatRangesInParallel(u64 count, const std::function<void(JsonPatternVisitor&, u64, u64)> &formatRange) {
+            struct Range {
+                std::string text;
+                bool commaPending;
+            };
+
+            formatInParallel(count, [&](u64 start, u64 end) {
+                Range range;
+
+                {
+                    BufferedOutput output([&](const u8 *data, size_t size) {
+                        range.text.append(reinterpret_cast<const char*>(data), size);
+                    });
+
+                    JsonPatternVisitor visitor(output);
+                    visitor.enableMetaInformation(this->isMetaInformationEnabled());
+                    visitor.m_indent = this->m_indent;
+
+                    formatRange(visitor, start, end);
+                    range.commaPending = visitor.m_commaPending;
+                }
+
+                return range;
+            }, [&](Range &&range) {
+                if (range.text.empty())
+                    return;
+
+                if (this->m_commaPending)
+                    this->m_output.write(",\n");
+
+                this->m_output.write(range.text);
+                this->m_commaPending = range.commaPending;
+            });
+        }
+
     private:
-        void addLine(const std::string &variableName, const std::string& str, bool noVariableName = false) {
-            this->m_result += std::string(this->m_indent, ' ');
-            if (!noVariableName && !this->m_inArray)
-                this->m_result += ::fmt::format("\"{}\": ", variableName);
+        void addLine(const std::string &variableName, std::string_view str, bool noVariableName = false) {
+            if (this->m_commaPending) {
+                this->m_output.write(",\n");
+                this->m_commaPending = false;
+            }
+
+            this->m_output.write(' ', this->m_indent);
+            if (!noVariableName && !this->m_inArray) {
+                this->m_output.write('"');
+                this->m_output.write(variableName);
+                this->m_output.write("\": ");
+            }
 
-            this->m_result  += str + "\n";
+            // Separating commas are only written once the next line shows up
+            if (str.ends_with(',')) {
+                this->m_output.write(str.substr(0, str.size() - 1));
+                this->m_commaPending = true;
+            } else {
+                this->m_output.write(str);
+                this->m_output.write('\n');
+            }
 
             this->m_inArray = false;
         }
@@ -66,10 +119,19 @@ namespace pl::gen::fmt {
         void formatArray(T *pattern) {
             addLine(pattern->getVariableName(), "[");
             pushIndent();
-            pattern->forEachEntry(0, pattern->getEntryCount(), [&](u64, auto member) {
-                this->m_inArray = true;
-                member->accept(*this);
-            });
+            if (this->beginParallelIteration(pattern)) {
+                this->formatRangesInParallel(pattern->getEntryCount(), [&](JsonPatternVisitor &visitor, u64 start, u64 end) {
+                    forEachEntryInRange(pattern, start, end, [&](u64, auto member) {
+                        visitor.m_inArray = true;
+                        member->accept(visitor);
+                    });
+                });
+            } else {
+                pattern->forEachEntry(0, pattern->getEntryCount(), [&](u64, auto member) {
+                    this->m_inArray = true;
+                    member->accept(*this);
+                });
+            }
             popIndent();
             addLine("", "],", true);
         }
@@ -109,33 +171,77 @@ namespace pl::gen::fmt {
         }
 
     private:
+        BufferedOutput &m_output;
         bool m_inArray = false;
-        std::string m_result;
+        bool m_commaPending = false;
         u32 m_indent = 0;
     };
 
-    class FormatterJson : public Formatter {
+    class FormatterJson : public StreamingFormatter {
     public:
-        FormatterJson() : Formatter("json") { }
+        FormatterJson() : StreamingFormatter("json") { }
         ~FormatterJson() override = default;
 
+        using StreamingFormatter::format;
+
         [[nodiscard]] std::string getFileExtension() const override { return ".json"; }
 
-        [[nodiscard]] std::vector<u8> format(const PatternLanguage &runtime) override {
-            JsonPatternVisitor visitor;
+        void format(const PatternLanguage &runtime, BufferedOutput &output) override {
+            JsonPatternVisitor visitor(output);
             visitor.enableMetaInformation(this->isMetaInformationEnabled());
+            visitor.enableParallelFormatting(this->isParallelFormattingEnabled());
+
+            output.write("{\n");
 
             visitor.pushIndent();
-            for (const auto& pattern : runtime.getAllPatterns()) {
-                pattern->accept(visitor);
+            const auto &patterns = runtime.getAllPatterns();
+            if (this->isParallelFormattingEnabled()) {
+                visitor.formatRangesInParallel(patterns.size(), [&](JsonPatternVisitor &rangeVisitor, u64 start, u64 end) {
+                    for (u64 i = start; i < end; i++)
+                        patterns[i]->accept(rangeVisitor);
+                });
+            } else {
+                for (const auto& pattern : patterns) {
+                    pattern->accept(visitor);
+                }
             }
             visitor.popIndent();
 
-            auto result = visitor.getResult();
-            result = ::fmt::format("{{\n{}}}", result);
-
-            return { result.begin(), result.end() };
+            output.write('}');
         }
+
+        /**
+         * @brief Writes patterns one at a time as a pattern sink hands them over, so they can be released right after
+         * @note The output is complete once the writer is destroyed and matches the output of format() for the same patterns.
+         * Patterns outside of the main section are skipped the same way
+         */
+        class PatternWriter {
+        public:
+            PatternWriter(const FormatterJson &formatter, BufferedOutput &output) : m_output(output), m_visitor(output) {
+                this->m_visitor.enableMetaInformation(formatter.isMetaInformationEnabled());
+                this->m_visitor.enableParallelFormatting(formatter.isParallelFormattingEnabled());
+
+                this->m_output.write("{\n");
+                this->m_visitor.pushIndent();
+            }
+
+            PatternWriter(const PatternWriter&) = delete;
+            PatternWriter &operator=(const PatternWriter&) = delete;
+
+            ~PatternWriter() {
+                this->m_visitor.popIndent();
+                this->m_output.write('}');
+            }
+
+            void write(ptrn::Pattern &pattern) {
+                if (pattern.getSection() == ptrn::Pattern::MainSectionId)
+                    pattern.accept(this->m_visitor);
+            }
+
+        private:
+            BufferedOutput &m_output;
+            JsonPatternVisitor m_visitor;
+        };
     };
 
 }
\ No newline at end of file
@@ -37,6 +37,25 @@ namespace pl::gen::fmt {
             this->m_indent -= indent;
         }
 
+        /**
+         * @brief Formats ranges of items on multiple threads, each with its own visitor, and appends the results in order
+         * @param count Number of items
+         * @param formatRange Function formatting the items in [start, end) using the visitor it's passed
+         */
+        void formatRangesInParallel(u64 count, const std::function<void(YamlPatternVisitor&, u64, u64)> &formatRange) {
+            formatInParallel(count, [&](u64 start, u64 end) {
+                YamlPatternVisitor visitor;
+                visitor.enableMetaInformation(this->isMetaInformationEnabled());
+                visitor.m_indent = this->m_indent;
+
+                formatRange(visitor, start, end);
+
+                return std::move(visitor.m_result);
+            }, [&](std::string &&result) {
+                this->m_result += result;
+            });
+        }
+
     private:
         void addLine(const std::string &variableName, const std::string &str = "", bool addDash = false) {
             this->m_result += std::string(this->m_indent, ' ');
@@ -53,10 +72,19 @@ namespace pl::gen::fmt {
         void formatArray(T *pattern) {
             addLine(pattern->getVariableName());
             pushIndent();
-            pattern->forEachEntry(0, pattern->getEntryCount(), [&](u64, auto member) {
-                this->m_inArray = true;
-                member->accept(*this);
-            });
+            if (this->beginParallelIteration(pattern)) {
+                this->formatRangesInParallel(pattern->getEntryCount(), [&](YamlPatternVisitor &visitor, u64 start, u64 end) {
+                    forEachEntryInRange(pattern, start, end, [&](u64, auto member) {
+                        visitor.m_inArray = true;
+                        member->accept(visitor);
+                    });
+                });
+            } else {
+                pattern->forEachEntry(0, pattern->getEntryCount(), [&](u64, auto member) {
+                    this->m_inArray = true;
+                    member->accept(*this);
+                });
+            }
             popIndent();
         }
 
@@ -120,9 +148,18 @@ namespace pl::gen::fmt {
         [[nodiscard]] std::vector<u8> format(const PatternLanguage &runtime) override {
             YamlPatternVisitor visitor;
             visitor.enableMetaInformation(this->isMetaInformationEnabled());
+            visitor.enableParallelFormatting(this->isParallelFormattingEnabled());
 
-            for (const auto& pattern : runtime.getAllPatterns()) {
-                pattern->accept(visitor);
+            const auto &patterns = runtime.getAllPatterns();
+            if (this->isParallelFormattingEnabled()) {
+                visitor.formatRangesInParallel(patterns.size(), [&](YamlPatternVisitor &rangeVisitor, u64 start, u64 end) {
+                    for (u64 i = start; i < end; i++)
+                        patterns[i]->accept(rangeVisitor);
+                });
+            } else {
+                for (const auto& pattern : patterns) {
+                    pattern->accept(visitor);
+                }
             }
 
             auto result = "---\n" + visitor.getResult();
@@ -6,6 +6,7 @@
 #include <cmath>
 #include <vector>
 #include <functional>
+#include <memory>
 #include <string>
 #include <optional>
 
@@ -76,4 +77,10 @@ namespace pl::api {
         bool dangerous;
     };
 
+    /**
+     * @brief Receives patterns as soon as they're complete
+     * @return True to keep the pattern in the results, false to release it once the sink returned
+     */
+    using PatternSink = std::function<bool(const std::shared_ptr<ptrn::Pattern> &)>;
+
 }
\ No newline at end of file
@@ -109,6 +109,18 @@ namespace pl::core::ast {
             }
         }
 
+        /**
+         * @brief Adds entries to a top-level dynamic array from an append checkpoint onwards
+         * @param evaluator Evaluator to use
+         * @param arrayPattern Array created by a previous evaluation
+         * @param entryIndex Index of the next entry
+         */
+        void resumeDynamicArray(Evaluator *evaluator, ptrn::PatternArrayDynamic *arrayPattern, u64 entryIndex) const {
+            evaluator->updateRuntime(this);
+
+            this->addDynamicArrayEntries(evaluator, arrayPattern, entryIndex);
+        }
+
         FunctionResult execute(Evaluator *evaluator) const override {
             evaluator->updateRuntime(this);
 
@@ -273,6 +285,16 @@ namespace pl::core::ast {
         }
 
         std::unique_ptr<ptrn::Pattern> createDynamicArray(Evaluator *evaluator) const {
+            auto arrayPattern = std::make_unique<ptrn::PatternArrayDynamic>(evaluator, evaluator->dataOffset(), 0);
+            arrayPattern->setVariableName(this->m_name);
+            arrayPattern->setSection(evaluator->getSectionId());
+
+            this->addDynamicArrayEntries(evaluator, arrayPattern.get(), 0);
+
+            return arrayPattern;
+        }
+
+        void addDynamicArrayEntries(Evaluator *evaluator, ptrn::PatternArrayDynamic *arrayPattern, u64 entryIndex) const {
             auto startArrayIndex = evaluator->getCurrentArrayIndex();
             ON_SCOPE_EXIT {
                 if (startArrayIndex.has_value())
@@ -281,18 +303,65 @@ namespace pl::core::ast {
                     evaluator->clearCurrentArrayIndex();
             };
 
-            auto arrayPattern = std::make_unique<ptrn::PatternArrayDynamic>(evaluator, evaluator->dataOffset(), 0);
-            arrayPattern->setVariableName(this->m_name);
-            arrayPattern->setSection(evaluator->getSectionId());
+            auto entries = arrayPattern->getEntries();
+            size_t size  = arrayPattern->getSize();
+
+            // In append mode the data may end in the middle of the last entry. That entry gets dropped and the end of the
+            // previous one is checkpointed so evaluation can continue from there once more data is available
+            const bool appending = evaluator->isAppendingTo(this) && arrayPattern->getSection() == ptrn::Pattern::MainSectionId;
+            bool reachedDataEnd = false;
+            bool droppedEntry = false;
+            bool whileSized = false;
+
+            auto isPastDataEnd = [&] {
+                return (evaluator->dataOffset() - evaluator->getDataBaseAddress()) > evaluator->getDataSize();
+            };
 
-            std::vector<std::shared_ptr<ptrn::Pattern>> entries;
+            auto createEntryPatterns = [&]() -> std::vector<std::shared_ptr<ptrn::Pattern>> {
+                if (!appending)
+                    return this->m_type->createPatterns(evaluator);
 
-            size_t size    = 0;
-            u64 entryIndex = 0;
+                const auto entryOffset = evaluator->dataOffset();
+                try {
+                    auto patterns = this->m_type->createPatterns(evaluator);
+                    if (!isPastDataEnd())
+                        return patterns;
+                } catch (err::EvaluatorError::Exception &) {
+                    if (!isPastDataEnd())
+                        throw;
+                }
+
+                evaluator->dataOffset() = entryOffset;
+                evaluator->setCurrentControlFlowStatement(ControlFlowStatement::Break);
+                reachedDataEnd = true;
+                droppedEntry = (entryOffset - evaluator->getDataBaseAddress()) < evaluator->getDataSize();
+
+                return { };
+            };
+
+            // Entries of top-level arrays may be streamed to the pattern sink. Entries are only handed over
+            // once the next entry gets added, because a continue statement may still discard the latest ones
+            const bool sinkEntries = evaluator->isSinkingArrayEntries(this);
+            size_t pendingEntries = 0;
+
+            auto sinkPendingEntries = [&] {
+                if (!sinkEntries)
+                    return;
+
+                auto end = entries.end();
+                auto kept = std::remove_if(end - pendingEntries, end, [&](const auto &entry) {
+                    return !evaluator->sinkPattern(entry);
+                });
+                entries.erase(kept, end);
+
+                pendingEntries = 0;
+            };
 
             auto addEntries = [&](std::vector<std::shared_ptr<ptrn::Pattern>> &&patterns) {
+                sinkPendingEntries();
+
                 for (auto &pattern : patterns) {
-                    pattern->setVariableName(fmt::format("[{}]", entryIndex));
+                    pattern->setArrayIndexName(entryIndex);
                     pattern->setEndian(arrayPattern->getEndian());
                     if (pattern->getSection() == ptrn::Pattern::MainSectionId)
                         pattern->setSection(arrayPattern->getSection());
@@ -301,6 +370,7 @@ namespace pl::core::ast {
                     entryIndex++;
 
                     entries.push_back(std::move(pattern));
+                    pendingEntries++;
 
                     evaluator->handleAbort();
                 }
@@ -311,6 +381,8 @@ namespace pl::core::ast {
                     entries.pop_back();
                     entryIndex--;
                 }
+
+                pendingEntries -= std::min<size_t>(count, pendingEntries);
             };
 
             if (this->m_size != nullptr) {
@@ -353,6 +425,8 @@ namespace pl::core::ast {
                         }
                     }
                 } else if (auto whileStatement = dynamic_cast<ASTNodeWhileStatement *>(sizeNode.get())) {
+                    whileSized = true;
+
                     while (whileStatement->evaluateCondition(evaluator)) {
                         auto limit = evaluator->getArrayLimit();
                         if (entryIndex > limit)
@@ -362,7 +436,7 @@ namespace pl::core::ast {
 
                         evaluator->setCurrentControlFlowStatement(ControlFlowStatement::None);
 
-                        auto patterns       = this->m_type->createPatterns(evaluator);
+                        auto patterns       = createEntryPatterns();
                         size_t patternCount = patterns.size();
 
                         if (arrayPattern->getSection() == ptrn::Pattern::MainSectionId)
@@ -394,7 +468,9 @@ namespace pl::core::ast {
 
                     evaluator->setCurrentControlFlowStatement(ControlFlowStatement::None);
 
-                    auto patterns = this->m_type->createPatterns(evaluator);
+                    auto patterns = createEntryPatterns();
+                    if (reachedDataEnd)
+                        break;
 
                     for (auto &pattern : patterns) {
                         std::vector<u8> buffer(pattern->getSize());
@@ -437,13 +513,17 @@ namespace pl::core::ast {
             }
 
 
+            sinkPendingEntries();
+
             if (arrayPattern->getEntryCount() > 0)
                 arrayPattern->setTypeName(arrayPattern->getEntry(0)->getTypeName());
 
             arrayPattern->setEntries(std::move(entries));
             arrayPattern->setSize(size);
 
-            return arrayPattern;
+            // Unsized arrays are complete once their terminator was found, while-sized ones may continue if more data shows up
+            if (appending && (reachedDataEnd || whileSized))
+                evaluator->setAppendCheckpoint(this, evaluator->dataOffset(), entryIndex, droppedEntry);
         }
     };
 
@@ -96,7 +96,7 @@ namespace pl::core::ast {
 
             auto addEntries = [&](std::vector<std::shared_ptr<ptrn::Pattern>> &&patterns) {
                 for (auto &pattern : patterns) {
-                    pattern->setVariableName(fmt::format("[{}]", entryIndex));
+                    pattern->setArrayIndexName(u64(entryIndex));
                     pattern->setEndian(arrayPattern->getEndian());
                     if (pattern->getSection() == ptrn::Pattern::MainSectionId)
                         pattern->setSection(arrayPattern->getSection());
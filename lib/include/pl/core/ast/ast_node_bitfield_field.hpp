@@ -41,7 +41,7 @@ namespace pl::core::ast {
                     [](auto &&offset) -> u8 { return static_cast<u8>(offset); }
             }, literal->getValue());
 
-            auto pattern = std::make_shared<ptrn::PatternBitfieldField>(evaluator, evaluator->dataOffset(), evaluator->getBitfieldBitOffset(), bitSize);
+            auto pattern = hlp::makeShared<ptrn::PatternBitfieldField>(evaluator, evaluator->dataOffset(), evaluator->getBitfieldBitOffset(), bitSize);
             pattern->setPadding(this->isPadding());
             pattern->setVariableName(this->getName());
 
@@ -26,7 +26,7 @@ namespace pl::core::ast {
         [[nodiscard]] std::vector<std::shared_ptr<ptrn::Pattern>> createPatterns(Evaluator *evaluator) const override {
             evaluator->updateRuntime(this);
 
-            auto pattern = std::make_shared<ptrn::PatternEnum>(evaluator, evaluator->dataOffset(), 0);
+            auto pattern = hlp::makeShared<ptrn::PatternEnum>(evaluator, evaluator->dataOffset(), 0);
 
             pattern->setSection(evaluator->getSectionId());
 
@@ -74,7 +74,7 @@ namespace pl::core::ast {
 
             auto &sizePattern = sizePatterns.front();
 
-            auto pattern = std::make_shared<ptrn::PatternPointer>(evaluator, pointerStartOffset, sizePattern->getSize());
+            auto pattern = hlp::makeShared<ptrn::PatternPointer>(evaluator, pointerStartOffset, sizePattern->getSize());
             pattern->setVariableName(this->m_name);
             pattern->setPointerTypePattern(std::move(sizePattern));
 
@@ -142,25 +142,19 @@ namespace pl::core::ast {
         [[nodiscard]] std::vector<std::shared_ptr<ptrn::Pattern>> createPatterns(Evaluator *evaluator) const override {
             evaluator->updateRuntime(this);
 
-            std::vector<std::shared_ptr<ptrn::Pattern>> searchScope;
+            // Scopes are referenced instead of copied and searched back to front. Entries of an iteratable are only fetched once a name is looked up in them
+            std::vector<const std::vector<std::shared_ptr<ptrn::Pattern>>*> searchScopes;
+            std::vector<std::shared_ptr<ptrn::Pattern>> searchEntries;
+            ptrn::Iteratable *searchIteratable = nullptr;
             std::shared_ptr<ptrn::Pattern> currPattern;
             i32 scopeIndex = 0;
             bool indexable = true;
 
-            if (!evaluator->isGlobalScope()) {
-                const auto &globalScope = evaluator->getGlobalScope().scope;
-                std::copy(globalScope->begin(), globalScope->end(), std::back_inserter(searchScope));
-            }
+            if (!evaluator->isGlobalScope())
+                searchScopes.push_back(evaluator->getGlobalScope().scope);
 
-            {
-                const auto &currScope = evaluator->getScope(0);
-                std::copy(currScope.scope->begin(), currScope.scope->end(), std::back_inserter(searchScope));
-            }
-
-            {
-                const auto &templateParameters = evaluator->getTemplateParameters();
-                std::copy(templateParameters.begin(), templateParameters.end(), std::back_inserter(searchScope));
-            }
+            searchScopes.push_back(evaluator->getScope(0).scope);
+            searchScopes.push_back(&evaluator->getTemplateParameters());
 
             for (const auto &part : this->getPath()) {
 
@@ -177,8 +171,9 @@ namespace pl::core::ast {
                         if (static_cast<size_t>(std::abs(scopeIndex)) >= evaluator->getScopeCount())
                             err::E0003.throwError("Cannot access parent of global scope.", {}, this);
 
-                        searchScope     = *evaluator->getScope(scopeIndex).scope;
-                        auto currParent = evaluator->getScope(scopeIndex).parent;
+                        searchScopes     = { evaluator->getScope(scopeIndex).scope };
+                        searchIteratable = nullptr;
+                        auto currParent  = evaluator->getScope(scopeIndex).parent;
 
                         if (currParent == nullptr) {
                             currPattern = nullptr;
@@ -188,7 +183,8 @@ namespace pl::core::ast {
 
                         continue;
                     } else if (name == "this") {
-                        searchScope = *evaluator->getScope(scopeIndex).scope;
+                        searchScopes     = { evaluator->getScope(scopeIndex).scope };
+                        searchIteratable = nullptr;
 
                         auto currParent = evaluator->getScope(0).parent;
 
@@ -198,12 +194,20 @@ namespace pl::core::ast {
                         currPattern = currParent;
                         continue;
                     } else {
+                        if (searchIteratable != nullptr) {
+                            searchEntries    = searchIteratable->getEntries();
+                            searchScopes     = { &searchEntries };
+                            searchIteratable = nullptr;
+                        }
+
                         bool found = false;
-                        for (auto iter = searchScope.crbegin(); iter != searchScope.crend(); ++iter) {
-                            if ((*iter)->getVariableName() == name) {
-                                currPattern = *iter;
-                                found       = true;
-                                break;
+                        for (auto scope = searchScopes.crbegin(); scope != searchScopes.crend() && !found; ++scope) {
+                            for (auto iter = (*scope)->crbegin(); iter != (*scope)->crend(); ++iter) {
+                                if ((*iter)->getVariableName() == name) {
+                                    currPattern = *iter;
+                                    found       = true;
+                                    break;
+                                }
                             }
                         }
 
@@ -249,9 +253,8 @@ namespace pl::core::ast {
 
                 auto indexPattern = currPattern.get();
 
-                if (auto iteratable = dynamic_cast<ptrn::Iteratable *>(indexPattern); iteratable != nullptr)
-                    searchScope = iteratable->getEntries();
-                else
+                searchIteratable = dynamic_cast<ptrn::Iteratable *>(indexPattern);
+                if (searchIteratable == nullptr)
                     indexable = false;
 
             }
@@ -26,7 +26,7 @@ namespace pl::core::ast {
         [[nodiscard]] std::vector<std::shared_ptr<ptrn::Pattern>> createPatterns(Evaluator *evaluator) const override {
             evaluator->updateRuntime(this);
 
-            auto pattern = std::make_shared<ptrn::PatternStruct>(evaluator, evaluator->dataOffset(), 0);
+            auto pattern = hlp::makeShared<ptrn::PatternStruct>(evaluator, evaluator->dataOffset(), 0);
 
             u64 startOffset = evaluator->dataOffset();
             std::vector<std::shared_ptr<ptrn::Pattern>> memberPatterns;
@@ -2,16 +2,20 @@
 
 #include <atomic>
 #include <bit>
+#include <limits>
 #include <map>
 #include <optional>
 #include <vector>
 #include <memory>
+#include <mutex>
 #include <unordered_set>
 #include <unordered_map>
 
 #include <pl/core/log_console.hpp>
 #include <pl/core/token.hpp>
 #include <pl/api.hpp>
+#include <pl/helpers/arena.hpp>
+#include <pl/helpers/stream_window.hpp>
 
 #include <fmt/format.h>
 
@@ -28,6 +32,7 @@ namespace pl::core {
     namespace ast {
         class ASTNode;
         class ASTNodeBitfieldField;
+        class ASTNodeArrayVariableDecl;
     }
 
     enum class DangerousFunctionPermission {
@@ -51,6 +56,7 @@ namespace pl::core {
     class Evaluator {
     public:
         Evaluator() = default;
+        ~Evaluator();
 
         [[nodiscard]] bool evaluate(const std::string &sourceCode, const std::vector<std::shared_ptr<ast::ASTNode>> &ast);
 
@@ -58,6 +64,19 @@ namespace pl::core {
             return this->m_patterns;
         }
 
+        /**
+         * @brief Drops all patterns created by the last evaluation and hands their memory back in one go once the last reference is gone
+         */
+        void releasePatterns();
+
+        /**
+         * @brief Gets the arena the patterns of the last evaluation are allocated from
+         * @return Arena or nullptr if nothing has been evaluated yet
+         */
+        [[nodiscard]] hlp::Arena* getPatternArena() const {
+            return this->m_patternArena;
+        }
+
         [[nodiscard]] LogConsole &getConsole() {
             return this->m_console;
         }
@@ -141,11 +160,33 @@ namespace pl::core {
         void setDataSource(u64 baseAddress, size_t dataSize, std::function<void(u64, u8*, size_t)> readerFunction, std::optional<std::function<void(u64, const u8*, size_t)>> writerFunction = std::nullopt) {
             this->m_dataBaseAddress = baseAddress;
             this->m_dataSize = dataSize;
+            this->m_streamWindow.reset();
 
             this->m_readerFunction = std::move(readerFunction);
             if (writerFunction.has_value()) this->m_writerFunction = std::move(writerFunction.value());
         }
 
+        constexpr static u64 UnboundedDataSize = std::numeric_limits<u64>::max() >> 1;
+
+        /**
+         * @brief Uses a non-seekable stream as data source
+         * @note The data size is unbounded until evaluation reaches the end of the stream
+         * @param streamWindow Window buffering the stream's data
+         */
+        void setStreamDataSource(std::shared_ptr<hlp::StreamWindow> streamWindow) {
+            this->m_dataBaseAddress = 0x00;
+            this->m_dataSize = UnboundedDataSize;
+
+            this->m_readerFunction = [streamWindow](u64 address, u8 *buffer, size_t size) {
+                streamWindow->read(address, buffer, size);
+            };
+            this->m_writerFunction = [](u64, u8*, size_t) {
+                err::E0011.throwError("Streams cannot be written to.");
+            };
+
+            this->m_streamWindow = std::move(streamWindow);
+        }
+
         void setDataBaseAddress(u64 baseAddress) {
             this->m_dataBaseAddress = baseAddress;
         }
@@ -158,7 +199,11 @@ namespace pl::core {
             return this->m_dataBaseAddress;
         }
 
-        [[nodiscard]] u64 getDataSize() const {
+        [[nodiscard]] u64 getDataSize() {
+            // The size of a stream is only known once its end has been reached. Checking for it may pull in more data
+            if (this->m_streamWindow != nullptr && !this->m_streamWindow->hasDataAt(this->m_currOffset))
+                return this->m_streamWindow->getPulledSize();
+
             return this->m_dataSize;
         }
 
@@ -332,6 +377,74 @@ namespace pl::core {
             this->m_dangerousFunctionCalledCallback = std::move(callback);
         }
 
+        /**
+         * @brief Sets a sink that receives every top-level pattern as soon as it's complete
+         * @note Patterns released by the sink can't be referenced by code that runs after them
+         * @param sink Sink to call or nullptr to keep all patterns
+         * @param includeArrayEntries Also pass each entry of top-level dynamic arrays to the sink before the array itself
+         */
+        void setPatternSink(api::PatternSink sink, bool includeArrayEntries) {
+            this->m_patternSink = std::move(sink);
+            this->m_sinkArrayEntries = includeArrayEntries;
+        }
+
+        /**
+         * @brief Enables append mode for data that only ever grows at its end, such as journals or capture files
+         * @note If the last top-level pattern is a while-sized or unsized array, the data may end in the middle of its last entry.
+         * That entry is dropped instead of failing and the end of the previous entry is checkpointed so resumeEvaluation()
+         * can continue from there once more data is available
+         * @param enabled Whether to enable append mode
+         */
+        void setAppendMode(bool enabled) {
+            this->m_appendMode = enabled;
+            this->m_appendCheckpoint.reset();
+        }
+
+        [[nodiscard]] bool isAppendingTo(const ast::ASTNode *arrayNode) const {
+            return this->m_appendMode && arrayNode == this->m_topLevelArrayNode;
+        }
+
+        void setAppendCheckpoint(const ast::ASTNodeArrayVariableDecl *arrayNode, u64 offset, u64 entryIndex, bool droppedEntry) {
+            this->m_appendCheckpoint = AppendCheckpoint { arrayNode, nullptr, offset, entryIndex, this->m_dataBaseAddress, this->m_dataSize, droppedEntry, { }, 0, { }, { } };
+        }
+
+        /**
+         * @brief Checks if the last evaluation can be resumed from its append checkpoint
+         * @return True if a checkpoint exists and the data only grew since it was taken
+         */
+        [[nodiscard]] bool canResumeEvaluation() const;
+
+        /**
+         * @brief Continues the last evaluation from its append checkpoint, adding entries for the newly available data
+         * @note Everything up to the checkpoint is kept as is, only the entry loop of the checkpointed array and the main function run again.
+         * Sections, heap and console output are restored to how they were before the main function ran, so its side effects are only applied once
+         * @param sourceCode Source code of the last evaluation, used for error messages
+         * @return True if the evaluation succeeded
+         */
+        bool resumeEvaluation(const std::string &sourceCode);
+
+        /**
+         * @brief Checks if any data read while deciding on the layout of the patterns lies in a range
+         * @note Every read of the main section during evaluation counts, such as array sizes, conditions or pointer targets.
+         * Bytes that were never read during evaluation only show up in the values of patterns
+         * @param address Start address of the range
+         * @param size Size of the range
+         * @return True if modifying the range may change the layout of the patterns
+         */
+        [[nodiscard]] bool isLayoutDependentOn(u64 address, size_t size) const;
+
+        [[nodiscard]] bool isSinkingArrayEntries(const ast::ASTNode *arrayNode) const {
+            return this->m_patternSink != nullptr && this->m_sinkArrayEntries && arrayNode == this->m_topLevelArrayNode;
+        }
+
+        /**
+         * @brief Passes a complete pattern to the pattern sink
+         * @return True if the pattern should be kept
+         */
+        [[nodiscard]] bool sinkPattern(const std::shared_ptr<ptrn::Pattern> &pattern) const {
+            return this->m_patternSink == nullptr || this->m_patternSink(pattern);
+        }
+
         void dangerousFunctionCalled() {
             this->allowDangerousFunctions(this->m_dangerousFunctionCalledCallback());
         }
@@ -360,9 +473,35 @@ namespace pl::core {
             return this->m_mainResult;
         }
 
-        void setCurrentArrayIndex(u64 index) { this->m_currArrayIndex = index; }
-        void clearCurrentArrayIndex() { this->m_currArrayIndex = std::nullopt; }
-        [[nodiscard]] std::optional<u64> getCurrentArrayIndex() const { return this->m_currArrayIndex; }
+        void setCurrentArrayIndex(u64 index) {
+            for (auto &[evaluatorId, currIndex] : s_currArrayIndices) {
+                if (evaluatorId == this->m_evaluatorId) {
+                    currIndex = index;
+                    return;
+                }
+            }
+
+            s_currArrayIndices.emplace_back(this->m_evaluatorId, index);
+        }
+
+        void clearCurrentArrayIndex() {
+            std::erase_if(s_currArrayIndices, [this](const auto &entry) { return entry.first == this->m_evaluatorId; });
+        }
+
+        [[nodiscard]] std::optional<u64> getCurrentArrayIndex() const {
+            for (const auto &[evaluatorId, currIndex] : s_currArrayIndices) {
+                if (evaluatorId == this->m_evaluatorId)
+                    return currIndex;
+            }
+
+            return std::nullopt;
+        }
+
+        /**
+         * @brief Gets the lock held while a pattern's formatter or transform function runs
+         * @note Functions work on the shared evaluator state so only one thread may execute them at a time
+         */
+        [[nodiscard]] std::recursive_mutex &getFunctionCallMutex() { return this->m_functionCallMutex; }
 
         void setDebugMode(bool enabled) {
             this->m_debugMode = enabled;
@@ -390,6 +529,11 @@ namespace pl::core {
         void patternCreated(ptrn::Pattern *pattern);
         void patternDestroyed(ptrn::Pattern *pattern);
 
+        bool runEvaluation(const std::string &sourceCode, const std::function<void()> &function);
+
+        void addLayoutRead(u64 address, size_t size);
+        void mergeLayoutReads();
+
     private:
         u64 m_currOffset = 0x00;
 
@@ -397,7 +541,7 @@ namespace pl::core {
         bool m_debugMode = false;
         LogConsole m_console;
 
-        u32 m_colorIndex = 0;
+        std::atomic<u32> m_colorIndex = 0;
 
         std::endian m_defaultEndian = std::endian::native;
         u64 m_evalDepth = 0;
@@ -405,7 +549,7 @@ namespace pl::core {
         u64 m_patternLimit = 0;
         u64 m_loopLimit = 0;
 
-        u64 m_currPatternCount = 0;
+        std::atomic<u64> m_currPatternCount = 0;
 
         std::atomic<bool> m_aborted;
 
@@ -427,8 +571,36 @@ namespace pl::core {
 
         std::vector<std::vector<u8>> m_heap;
         std::map<u32, PatternLocalData> m_patternLocalStorage;
+        std::mutex m_patternLocalStorageMutex;
+        std::recursive_mutex m_functionCallMutex;
 
         std::function<bool()> m_dangerousFunctionCalledCallback = []{ return false; };
+        api::PatternSink m_patternSink;
+        bool m_sinkArrayEntries = false;
+        const ast::ASTNode *m_topLevelArrayNode = nullptr;
+
+        struct AppendCheckpoint {
+            const ast::ASTNodeArrayVariableDecl *arrayNode;
+            std::shared_ptr<ptrn::Pattern> arrayPattern;
+            u64 offset, entryIndex;
+            u64 dataBaseAddress, dataSize;
+            bool droppedEntry;
+
+            // State right before the main function ran
+            std::map<u64, api::Section> sections;
+            u64 sectionId;
+            std::vector<std::vector<u8>> heap;
+            std::vector<std::pair<LogConsole::Level, std::string>> consoleLog;
+        };
+
+        bool m_appendMode = false;
+        std::optional<AppendCheckpoint> m_appendCheckpoint;
+
+        struct LayoutRead {
+            u64 start, end;
+        };
+
+        std::vector<LayoutRead> m_layoutReads;
         std::function<void()> m_breakpointHitCallback = []{ };
         std::atomic<DangerousFunctionPermission> m_allowDangerousFunctions = DangerousFunctionPermission::Ask;
         ControlFlowStatement m_currControlFlowStatement = ControlFlowStatement::None;
@@ -436,6 +608,7 @@ namespace pl::core {
         u8 m_bitfieldBitOffset = 0;
 
         std::vector<std::shared_ptr<ptrn::Pattern>> m_patterns;
+        hlp::Arena *m_patternArena = nullptr;
 
         u64 m_dataBaseAddress = 0x00;
         u64 m_dataSize = 0x00;
@@ -445,8 +618,15 @@ namespace pl::core {
         std::function<void(u64, u8*, size_t)> m_writerFunction = [](u64, u8*, size_t){
             err::E0011.throwError("No memory has been attached. Reading is disabled.");
         };
+        std::mutex m_dataSourceMutex;
 
-        std::optional<u64> m_currArrayIndex;
+        std::shared_ptr<hlp::StreamWindow> m_streamWindow;
+
+        // Formatters may iterate over arrays on multiple threads at once and a thread may work with multiple evaluators,
+        // so every thread tracks its own index for each evaluator. Entries are removed again once the index is cleared
+        static thread_local std::vector<std::pair<u64, u64>> s_currArrayIndices;
+        static std::atomic<u64> s_nextEvaluatorId;
+        const u64 m_evaluatorId = s_nextEvaluatorId.fetch_add(1);
 
         std::unordered_set<int> m_breakpoints;
         std::optional<u32> m_lastPauseLine;
@@ -454,10 +634,7 @@ namespace pl::core {
         u32 getNextPatternColor() {
             constexpr static std::array Palette = { 0x70B4771F, 0x700E7FFF, 0x702CA02C, 0x702827D6, 0x70BD6794, 0x704B568C, 0x70C277E3, 0x7022BDBC, 0x70CFBE17 };
 
-            auto index = this->m_colorIndex;
-            this->m_colorIndex = (this->m_colorIndex + 1) % Palette.size();
-
-            return Palette[index];
+            return Palette[this->m_colorIndex.fetch_add(1) % Palette.size()];
         }
 
         friend class pl::ptrn::PatternCreationLimiter;
@@ -24,6 +24,7 @@ namespace pl::core {
         };
 
         [[nodiscard]] const auto &getLog() const { return this->m_consoleLog; }
+        void setLog(std::vector<std::pair<Level, std::string>> log) { this->m_consoleLog = std::move(log); }
 
         void log(Level level, const std::string &message) const {
             if (u8(level) >= u8(this->m_logLevel))
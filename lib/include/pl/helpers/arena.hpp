@@ -0,0 +1,150 @@
+#pragma once
+
+#include <pl/helpers/types.hpp>
+
+#include <array>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+namespace pl::hlp {
+
+    /**
+     * @brief Slab allocator for many small, similarly sized objects such as patterns
+     * @note Allocations are served from size classes inside SlabSize aligned slabs, so freeing an object
+     * only pushes it onto a free list. Once the owner released the arena and the last allocation has been
+     * returned, all slabs are handed back to the system in one go.
+     */
+    class Arena {
+    public:
+        constexpr static size_t SlabSize            = 256 * 1024;
+        constexpr static size_t Granularity         = 16;
+        constexpr static size_t MaxAllocationSize   = 512;
+
+        /**
+         * @brief Creates a new arena owned by the caller
+         * @return Arena that needs to be given up using release()
+         */
+        [[nodiscard]] static Arena* create();
+
+        /**
+         * @brief Gives up ownership of the arena. Its memory is freed as soon as no allocations are alive anymore
+         */
+        void release();
+
+        /**
+         * @brief Allocates memory from the arena that's current on this thread or from the default arena
+         * @param size Number of bytes to allocate
+         * @return Pointer to the allocated memory
+         */
+        [[nodiscard]] static void* allocate(size_t size);
+
+        /**
+         * @brief Returns memory obtained through allocate() to the arena it was allocated from
+         * @param pointer Pointer to the memory
+         * @param size Size passed to allocate()
+         */
+        static void deallocate(void *pointer, size_t size);
+
+        /**
+         * @brief Gets the arena allocate() uses on the current thread
+         * @return Current arena or nullptr if the default arena is used
+         */
+        [[nodiscard]] static Arena* getCurrent();
+
+        /**
+         * @brief Makes an arena the target of allocate() on the current thread for the lifetime of the scope
+         */
+        class Scope {
+        public:
+            explicit Scope(Arena *arena);
+            ~Scope();
+
+            Scope(const Scope&) = delete;
+            Scope& operator=(const Scope&) = delete;
+
+        private:
+            Arena *m_prevArena;
+        };
+
+        /**
+         * @brief Gets the number of live allocations
+         * @return Number of allocations
+         */
+        [[nodiscard]] size_t getAllocationCount() const;
+
+    private:
+        Arena() = default;
+        ~Arena();
+
+        constexpr static size_t SizeClassCount = MaxAllocationSize / Granularity;
+
+        struct Slab {
+            Arena *arena;
+        };
+
+        struct FreeNode {
+            FreeNode *next;
+        };
+
+        [[nodiscard]] static Arena* getDefaultArena();
+
+        void* allocateFromSlab(size_t sizeClass);
+        void deallocateToSlab(void *pointer, size_t sizeClass);
+
+        void addToFreeList(void *pointer, size_t sizeClass);
+        void addSlab();
+        void recycle(u8 *begin, u8 *end);
+        void trim();
+
+        mutable std::mutex m_mutex;
+
+        std::array<FreeNode*, SizeClassCount> m_freeLists = { };
+        u8 *m_bumpPointer = nullptr, *m_bumpEnd = nullptr;
+        std::vector<Slab*> m_slabs;
+
+        size_t m_allocationCount = 0;
+        bool m_released = false;
+    };
+
+    /**
+     * @brief Standard allocator that allocates from the arena that's current on this thread
+     * @note Used with std::allocate_shared so the shared object and its control block end up in the same arena allocation
+     */
+    template<typename T>
+    class ArenaAllocator {
+    public:
+        using value_type = T;
+
+        static_assert(alignof(T) <= Arena::Granularity, "Type is aligned more strictly than the arena guarantees");
+
+        ArenaAllocator() = default;
+
+        template<typename U>
+        ArenaAllocator(const ArenaAllocator<U>&) noexcept { }
+
+        [[nodiscard]] T* allocate(size_t count) {
+            return static_cast<T*>(Arena::allocate(count * sizeof(T)));
+        }
+
+        void deallocate(T *pointer, size_t count) noexcept {
+            Arena::deallocate(pointer, count * sizeof(T));
+        }
+
+        template<typename U>
+        bool operator==(const ArenaAllocator<U>&) const noexcept {
+            return true;
+        }
+    };
+
+    /**
+     * @brief Creates a shared object in the arena that's current on this thread
+     * @param args Arguments passed on to the constructor of T
+     * @return Shared pointer to the new object
+     */
+    template<typename T, typename ... Args>
+    [[nodiscard]] std::shared_ptr<T> makeShared(Args && ... args) {
+        return std::allocate_shared<T>(ArenaAllocator<T>(), std::forward<Args>(args)...);
+    }
+
+}
@@ -0,0 +1,198 @@
+#pragma once
+
+#include <pl/helpers/utils.hpp>
+
+#include <array>
+#include <span>
+#include <string>
+
+namespace pl::hlp {
+
+    /**
+     * @brief Reverses the order of the lowest bits of a value
+     * @param value Value to reflect
+     * @param bits Number of bits to reflect
+     * @return Reflected value
+     */
+    [[nodiscard]] constexpr u64 reflectBits(u64 value, size_t bits) {
+        u64 result = 0;
+        for (size_t i = 0; i < bits; i++) {
+            result = (result << 1) | (value & 1);
+            value >>= 1;
+        }
+
+        return result;
+    }
+
+    /**
+     * @brief Streaming CRC with arbitrary parameters
+     * @note Parameters follow the Rocksoft model. Data is processed eight bytes at a time using slice-by-8 tables
+     */
+    template<size_t Bits> requires (Bits == 32 || Bits == 64)
+    class Crc {
+    public:
+        using ValueType = SizeType<Bits / 8>;
+
+        Crc(ValueType polynomial, ValueType init, ValueType xorOut, bool reflectIn, bool reflectOut)
+            : m_xorOut(xorOut), m_reflectIn(reflectIn), m_reflectOut(reflectOut) {
+            // Reflected CRCs are computed on a reflected register so their bytes can be shifted out at the bottom
+            if (reflectIn) {
+                const auto reflectedPolynomial = ValueType(reflectBits(polynomial, Bits));
+                for (u32 byte = 0; byte < 256; byte++) {
+                    ValueType value = byte;
+                    for (u32 bit = 0; bit < 8; bit++)
+                        value = (value & 1) ? (value >> 1) ^ reflectedPolynomial : value >> 1;
+
+                    this->m_tables[0][byte] = value;
+                }
+
+                for (u32 slice = 1; slice < this->m_tables.size(); slice++) {
+                    for (u32 byte = 0; byte < 256; byte++) {
+                        const auto previous = this->m_tables[slice - 1][byte];
+                        this->m_tables[slice][byte] = (previous >> 8) ^ this->m_tables[0][previous & 0xFF];
+                    }
+                }
+
+                this->m_value = ValueType(reflectBits(init, Bits));
+            } else {
+                for (u32 byte = 0; byte < 256; byte++) {
+                    ValueType value = ValueType(byte) << (Bits - 8);
+                    for (u32 bit = 0; bit < 8; bit++)
+                        value = (value >> (Bits - 1)) ? (value << 1) ^ polynomial : value << 1;
+
+                    this->m_tables[0][byte] = value;
+                }
+
+                for (u32 slice = 1; slice < this->m_tables.size(); slice++) {
+                    for (u32 byte = 0; byte < 256; byte++) {
+                        const auto previous = this->m_tables[slice - 1][byte];
+                        this->m_tables[slice][byte] = (previous << 8) ^ this->m_tables[0][previous >> (Bits - 8)];
+                    }
+                }
+
+                this->m_value = init;
+            }
+        }
+
+        void process(std::span<const u8> data) {
+            const auto &tables = this->m_tables;
+            auto value = this->m_value;
+
+            size_t i = 0;
+            if (this->m_reflectIn) {
+                for (; i + sizeof(u64) <= data.size(); i += sizeof(u64)) {
+                    u64 block = 0;
+                    for (size_t byte = 0; byte < sizeof(u64); byte++)
+                        block |= u64(data[i + byte]) << (byte * 8);
+
+                    block ^= value;
+                    value = tables[7][block & 0xFF]         ^ tables[6][(block >> 8) & 0xFF]  ^
+                            tables[5][(block >> 16) & 0xFF] ^ tables[4][(block >> 24) & 0xFF] ^
+                            tables[3][(block >> 32) & 0xFF] ^ tables[2][(block >> 40) & 0xFF] ^
+                            tables[1][(block >> 48) & 0xFF] ^ tables[0][block >> 56];
+                }
+
+                for (; i < data.size(); i++)
+                    value = (value >> 8) ^ tables[0][(value ^ data[i]) & 0xFF];
+            } else {
+                for (; i + sizeof(u64) <= data.size(); i += sizeof(u64)) {
+                    u64 block = 0;
+                    for (size_t byte = 0; byte < sizeof(u64); byte++)
+                        block = (block << 8) | data[i + byte];
+
+                    block ^= u64(value) << (64 - Bits);
+                    value = tables[7][block >> 56]          ^ tables[6][(block >> 48) & 0xFF] ^
+                            tables[5][(block >> 40) & 0xFF] ^ tables[4][(block >> 32) & 0xFF] ^
+                            tables[3][(block >> 24) & 0xFF] ^ tables[2][(block >> 16) & 0xFF] ^
+                            tables[1][(block >> 8) & 0xFF]  ^ tables[0][block & 0xFF];
+                }
+
+                for (; i < data.size(); i++)
+                    value = ValueType(value << 8) ^ tables[0][(value >> (Bits - 8)) ^ data[i]];
+            }
+
+            this->m_value = value;
+        }
+
+        [[nodiscard]] ValueType getResult() const {
+            auto result = this->m_value;
+            if (this->m_reflectIn != this->m_reflectOut)
+                result = ValueType(reflectBits(result, Bits));
+
+            return result ^ this->m_xorOut;
+        }
+
+    private:
+        std::array<std::array<ValueType, 256>, 8> m_tables;
+        ValueType m_value;
+        ValueType m_xorOut;
+        bool m_reflectIn, m_reflectOut;
+    };
+
+    /**
+     * @brief Streaming Adler-32 checksum
+     */
+    class Adler32 {
+    public:
+        void process(std::span<const u8> data);
+        [[nodiscard]] u32 getResult() const { return (this->m_b << 16) | this->m_a; }
+
+    private:
+        u32 m_a = 1, m_b = 0;
+    };
+
+    /**
+     * @brief Streaming XXH64, a fast non-cryptographic hash
+     */
+    class XxHash64 {
+    public:
+        explicit XxHash64(u64 seed = 0);
+
+        void process(std::span<const u8> data);
+        [[nodiscard]] u64 getResult() const;
+
+    private:
+        std::array<u64, 4> m_lanes;
+        std::array<u8, 32> m_buffer = { };
+        size_t m_bufferSize = 0;
+        u64 m_totalSize = 0;
+        u64 m_seed;
+    };
+
+    /**
+     * @brief Streaming SHA-1
+     */
+    class Sha1 {
+    public:
+        void process(std::span<const u8> data);
+        [[nodiscard]] std::array<u8, 20> getResult() const;
+
+    private:
+        void processBlock(const u8 *block);
+
+        std::array<u32, 5> m_state = { 0x67452301, 0xEFCDAB89, 0x98BADCFE, 0x10325476, 0xC3D2E1F0 };
+        std::array<u8, 64> m_buffer = { };
+        size_t m_bufferSize = 0;
+        u64 m_totalSize = 0;
+    };
+
+    /**
+     * @brief Streaming SHA-256
+     */
+    class Sha256 {
+    public:
+        void process(std::span<const u8> data);
+        [[nodiscard]] std::array<u8, 32> getResult() const;
+
+    private:
+        void processBlock(const u8 *block);
+
+        std::array<u32, 8> m_state = {
+            0x6A09E667, 0xBB67AE85, 0x3C6EF372, 0xA54FF53A, 0x510E527F, 0x9B05688C, 0x1F83D9AB, 0x5BE0CD19
+        };
+        std::array<u8, 64> m_buffer = { };
+        size_t m_bufferSize = 0;
+        u64 m_totalSize = 0;
+    };
+
+}
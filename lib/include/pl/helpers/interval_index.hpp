@@ -0,0 +1,189 @@
+#pragma once
+
+#include <pl/helpers/types.hpp>
+
+#include <algorithm>
+#include <array>
+#include <vector>
+
+namespace pl::hlp {
+
+    /**
+     * @brief Static interval index stored in flat arrays sorted by start address
+     * @note Every interval takes up four addresses plus its value and no pointers are involved. Lookups binary search
+     * the start addresses and use the running maximum of the end addresses to find where overlapping intervals begin.
+     * If long intervals make that scan too expensive, an implicit binary search tree over the same arrays, augmented with
+     * the largest end address of each subtree, is used instead.
+     */
+    template<typename T>
+    class IntervalIndex {
+    public:
+        struct Interval {
+            u64 start, end;
+            T value;
+        };
+
+        IntervalIndex() = default;
+
+        /**
+         * @brief Builds the index
+         * @param intervals Intervals to add. Start and end addresses are inclusive
+         */
+        explicit IntervalIndex(std::vector<Interval> intervals) {
+            std::stable_sort(intervals.begin(), intervals.end(), [](const Interval &left, const Interval &right) {
+                return left.start < right.start;
+            });
+
+            const auto count = intervals.size();
+            this->m_starts.reserve(count);
+            this->m_ends.reserve(count);
+            this->m_prefixMaxEnds.reserve(count);
+            this->m_values.reserve(count);
+
+            u64 maxEnd = 0;
+            for (auto &interval : intervals) {
+                maxEnd = std::max(maxEnd, interval.end);
+
+                this->m_starts.push_back(interval.start);
+                this->m_ends.push_back(interval.end);
+                this->m_prefixMaxEnds.push_back(maxEnd);
+                this->m_values.push_back(std::move(interval.value));
+            }
+
+            this->m_maxLevel = this->buildTree();
+        }
+
+        /**
+         * @brief Calls a function for every interval overlapping the given range
+         * @param start Start address of the range
+         * @param end End address of the range, inclusive
+         * @param callback Function called with the start address, end address and value of each overlapping interval in order of their start address
+         */
+        template<typename Callback>
+        void findOverlapping(u64 start, u64 end, Callback &&callback) const {
+            const auto count = this->m_starts.size();
+
+            // Intervals starting inside of the range always overlap it
+            const auto firstInside = size_t(std::lower_bound(this->m_starts.begin(), this->m_starts.end(), start) - this->m_starts.begin());
+
+            // Intervals before the first one whose running maximum end reaches the range all end before it
+            const auto firstCandidate = size_t(std::lower_bound(this->m_prefixMaxEnds.begin(), this->m_prefixMaxEnds.begin() + firstInside, start) - this->m_prefixMaxEnds.begin());
+
+            if (firstInside - firstCandidate > LinearScanLimit) {
+                this->findOverlappingInTree(start, end, callback);
+                return;
+            }
+
+            for (auto i = firstCandidate; i < firstInside; i++) {
+                if (this->m_ends[i] >= start)
+                    callback(this->m_starts[i], this->m_ends[i], this->m_values[i]);
+            }
+
+            for (auto i = firstInside; i < count && this->m_starts[i] <= end; i++)
+                callback(this->m_starts[i], this->m_ends[i], this->m_values[i]);
+        }
+
+        /**
+         * @brief Gets all intervals overlapping the given range
+         * @param start Start address of the range
+         * @param end End address of the range, inclusive
+         * @return Overlapping intervals in order of their start address
+         */
+        [[nodiscard]] std::vector<Interval> findOverlapping(u64 start, u64 end) const {
+            std::vector<Interval> result;
+            this->findOverlapping(start, end, [&](u64 intervalStart, u64 intervalEnd, const T &value) {
+                result.push_back({ intervalStart, intervalEnd, value });
+            });
+
+            return result;
+        }
+
+        [[nodiscard]] size_t size() const { return this->m_starts.size(); }
+        [[nodiscard]] bool empty() const { return this->m_starts.empty(); }
+
+    private:
+        constexpr static size_t LinearScanLimit = 32;
+
+        template<typename Callback>
+        void findOverlappingInTree(u64 start, u64 end, Callback &callback) const {
+            struct StackEntry {
+                i64 index;
+                i32 level;
+                bool leftDone;
+            };
+
+            const auto count = i64(this->m_starts.size());
+            if (count == 0)
+                return;
+
+            std::array<StackEntry, 64> stack;
+            size_t stackSize = 0;
+
+            stack[stackSize++] = { (i64(1) << this->m_maxLevel) - 1, this->m_maxLevel, false };
+
+            while (stackSize > 0) {
+                const auto node = stack[--stackSize];
+
+                if (node.level <= 3) {
+                    // Small subtrees are cheaper to scan linearly
+                    const i64 first = node.index >> node.level << node.level;
+                    const i64 last  = std::min(first + (i64(1) << (node.level + 1)) - 1, count);
+
+                    for (i64 i = first; i < last && this->m_starts[i] <= end; i++) {
+                        if (start <= this->m_ends[i])
+                            callback(this->m_starts[i], this->m_ends[i], this->m_values[i]);
+                    }
+                } else if (!node.leftDone) {
+                    const i64 left = node.index - (i64(1) << (node.level - 1));
+
+                    stack[stackSize++] = { node.index, node.level, true };
+                    if (left >= count || this->m_maxEnds[left] >= start)
+                        stack[stackSize++] = { left, node.level - 1, false };
+                } else if (node.index < count && this->m_starts[node.index] <= end) {
+                    if (start <= this->m_ends[node.index])
+                        callback(this->m_starts[node.index], this->m_ends[node.index], this->m_values[node.index]);
+
+                    stack[stackSize++] = { node.index + (i64(1) << (node.level - 1)), node.level - 1, false };
+                }
+            }
+        }
+
+        i32 buildTree() {
+            const auto count = i64(this->m_starts.size());
+            if (count == 0)
+                return 0;
+
+            this->m_maxEnds = this->m_ends;
+
+            // Leaves sit at even indices, their parents at odd ones. Each inner node stores the largest end of its subtree
+            i64 lastIndex = (count - 1) & ~i64(1);
+            u64 lastMaxEnd = this->m_ends[lastIndex];
+
+            i32 level = 1;
+            for (; (i64(1) << level) <= count; level++) {
+                const i64 offset = i64(1) << (level - 1);
+                const i64 first  = (offset << 1) - 1;
+                const i64 step   = offset << 2;
+
+                for (i64 i = first; i < count; i += step) {
+                    const u64 leftMaxEnd  = this->m_maxEnds[i - offset];
+                    const u64 rightMaxEnd = i + offset < count ? this->m_maxEnds[i + offset] : lastMaxEnd;
+
+                    this->m_maxEnds[i] = std::max({ this->m_ends[i], leftMaxEnd, rightMaxEnd });
+                }
+
+                // Move up to the parent of the last node to find the largest end of the rightmost, possibly incomplete, subtree
+                lastIndex = ((lastIndex >> level) & 1) != 0 ? lastIndex - offset : lastIndex + offset;
+                if (lastIndex < count)
+                    lastMaxEnd = std::max(lastMaxEnd, this->m_maxEnds[lastIndex]);
+            }
+
+            return level - 1;
+        }
+
+        std::vector<u64> m_starts, m_ends, m_maxEnds, m_prefixMaxEnds;
+        std::vector<T> m_values;
+        i32 m_maxLevel = 0;
+    };
+
+}
@@ -0,0 +1,71 @@
+#pragma once
+
+#include <pl/helpers/types.hpp>
+
+#include <atomic>
+#include <condition_variable>
+#include <mutex>
+#include <thread>
+#include <type_traits>
+#include <vector>
+
+namespace pl::hlp {
+
+    /**
+     * @brief Process-wide pool of worker threads used by parallelFor()
+     * @note The threads are started on first use and live until the process exits
+     */
+    class ThreadPool {
+    public:
+        using Task = void(*)(void *context, size_t index);
+
+        ThreadPool(const ThreadPool&) = delete;
+        ThreadPool& operator=(const ThreadPool&) = delete;
+
+        [[nodiscard]] static ThreadPool& getInstance();
+
+        /**
+         * @brief Calls a task for every index in [0, count) on the calling thread and all idle workers
+         * @note Returns once every index has been processed. Workers allocate from the arena that's current on the
+         * calling thread. Tasks may call run() themselves, the nested indices are then processed by the calling worker
+         * and any other worker that's idle at that point. The first exception thrown by the task stops the remaining
+         * indices from being processed and is rethrown
+         * @param count Number of indices
+         * @param task Task to run
+         * @param context Pointer passed on to the task
+         */
+        void run(size_t count, Task task, void *context);
+
+    private:
+        struct Job;
+
+        ThreadPool();
+        ~ThreadPool();
+
+        void workerLoop();
+        [[nodiscard]] Job* findJob() const;
+
+        std::mutex m_mutex;
+        std::condition_variable m_jobAdded, m_workerLeft;
+        std::vector<Job*> m_jobs;
+        std::vector<std::thread> m_workers;
+        bool m_stopping = false;
+    };
+
+    /**
+     * @brief Calls a function for every index in [0, count) spread over all hardware threads
+     * @note Indices are handed out one at a time, so threads that finish early keep picking up the remaining work.
+     * The first exception thrown by the function stops all threads and is rethrown once they finished
+     * @param count Number of indices
+     * @param function Function called with each index
+     */
+    template<typename Function>
+    void parallelFor(size_t count, Function &&function) {
+        using FunctionType = std::remove_reference_t<Function>;
+
+        ThreadPool::getInstance().run(count, [](void *context, size_t index) {
+            (*static_cast<FunctionType*>(context))(index);
+        }, const_cast<std::remove_const_t<FunctionType>*>(&function));
+    }
+
+}
@@ -0,0 +1,62 @@
+#pragma once
+
+#include <pl/helpers/types.hpp>
+
+#include <span>
+#include <string>
+#include <vector>
+
+namespace pl::hlp {
+
+    /**
+     * @brief Searches data for many byte signatures with wildcards at once
+     * @note Signatures are written as hex bytes such as "4D 5A ?? ?? 50 45". A "?" matches any value of a single nibble.
+     * All signatures are packed into the bits of a few 64 bit words and matched together using the bit-parallel
+     * Shift-And algorithm, so every byte of the data is only looked at once no matter how many signatures there are.
+     * The state is kept between calls to scan, which allows the data to be fed in chunks without any overlap
+     */
+    class SignatureScanner {
+    public:
+        constexpr static size_t MaxSignatureSize = 64;
+
+        struct Hit {
+            u64 address;
+            u32 signature;
+        };
+
+        /**
+         * @brief Compiles a set of signatures
+         * @note Throws an evaluator error if a signature is empty, longer than MaxSignatureSize or malformed
+         * @param signatures Signatures to search for
+         */
+        explicit SignatureScanner(const std::vector<std::string> &signatures);
+
+        /**
+         * @brief Scans the next chunk of data
+         * @param address Address of the first byte of the chunk. Consecutive calls need to pass consecutive chunks
+         * @param data Data to scan
+         * @param hits Receives every signature that ends in this chunk, ordered by their end address
+         */
+        void scan(u64 address, std::span<const u8> data, std::vector<Hit> &hits);
+
+        /**
+         * @brief Forgets about partial matches so scanning can start over at a new address
+         */
+        void reset();
+
+        [[nodiscard]] size_t getSignatureCount() const { return this->m_signatureSizes.size(); }
+
+    private:
+        void addHits(u64 address, size_t word, u64 bits, std::vector<Hit> &hits) const;
+
+        size_t m_wordCount = 0;
+
+        // Indexed by byte value times word count plus word, so all words of a byte lie next to each other
+        std::vector<u64> m_byteMasks;
+        std::vector<u64> m_startMasks, m_endMasks, m_state;
+
+        std::vector<u32> m_bitSignatures;
+        std::vector<u32> m_signatureSizes;
+    };
+
+}
@@ -0,0 +1,56 @@
+#pragma once
+
+#include <pl/helpers/types.hpp>
+
+#include <functional>
+#include <vector>
+
+namespace pl::hlp {
+
+    /**
+     * @brief Buffers the data of a non-seekable stream, such as a pipe or a socket, in a sliding window
+     * @note Data is pulled from the stream as reads advance. Only the most recently pulled data is kept around,
+     * reading anything that has already been dropped from the window fails
+     */
+    class StreamWindow {
+    public:
+        /**
+         * @brief Function reading the next chunk of the stream
+         * @return Number of bytes read. Zero marks the end of the stream
+         */
+        using ReadFunction = std::function<size_t(u8 *buffer, size_t size)>;
+
+        StreamWindow(ReadFunction readFunction, size_t windowSize);
+
+        /**
+         * @brief Reads data from the stream, pulling in more data if necessary
+         * @note Bytes past the end of the stream are filled with zeros
+         * @param address Address to read from, relative to the start of the stream
+         * @param buffer Buffer to read into
+         * @param size Number of bytes to read
+         */
+        void read(u64 address, u8 *buffer, size_t size);
+
+        /**
+         * @brief Checks if the stream contains data at an address, pulling in more data if necessary
+         * @param address Address to check
+         * @return True if the address lies before the end of the stream
+         */
+        [[nodiscard]] bool hasDataAt(u64 address);
+
+        [[nodiscard]] bool isEndReached() const { return this->m_endReached; }
+        [[nodiscard]] u64 getWindowStart() const { return this->m_windowStart; }
+        [[nodiscard]] u64 getPulledSize() const { return this->m_windowStart + this->m_buffer.size(); }
+
+    private:
+        void pull(u64 start, u64 end);
+
+        ReadFunction m_readFunction;
+        size_t m_windowSize;
+
+        std::vector<u8> m_buffer;
+        u64 m_windowStart = 0;
+        bool m_endReached = false;
+    };
+
+}
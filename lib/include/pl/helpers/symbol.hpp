@@ -0,0 +1,34 @@
+#pragma once
+
+#include <string>
+#include <string_view>
+
+namespace pl::hlp {
+
+    /**
+     * @brief Handle to a string stored in a process-wide, sharded symbol table
+     * @note Equal strings always resolve to the same handle, so a Symbol is a single pointer in size
+     * and can be copied and compared without touching the string data.
+     */
+    class Symbol {
+    public:
+        constexpr Symbol() = default;
+        explicit Symbol(std::string_view string) : m_string(string.empty() ? nullptr : intern(string)) { }
+
+        [[nodiscard]] const std::string& get() const {
+            static const std::string empty;
+
+            return this->m_string == nullptr ? empty : *this->m_string;
+        }
+
+        [[nodiscard]] bool empty() const { return this->m_string == nullptr; }
+
+        [[nodiscard]] bool operator==(const Symbol &other) const = default;
+
+    private:
+        static const std::string* intern(std::string_view string);
+
+        const std::string *m_string = nullptr;
+    };
+
+}
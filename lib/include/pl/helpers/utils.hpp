@@ -8,6 +8,7 @@
 #include <limits>
 #include <memory>
 #include <optional>
+#include <span>
 #include <string>
 #include <type_traits>
 #include <variant>
@@ -93,6 +94,49 @@ namespace pl::hlp {
         return changeEndianess(value, sizeof(value), endian);
     }
 
+    /**
+     * @brief Code paths the vectorized buffer helpers can take
+     */
+    enum class InstructionSet {
+        Scalar,
+        SSE2,
+        AVX2
+    };
+
+    /**
+     * @brief Lists the code paths the vectorized buffer helpers can take on this CPU
+     * @return Supported instruction sets, always starting with Scalar and ending with the one used by default
+     */
+    [[nodiscard]] std::vector<InstructionSet> getSupportedInstructionSets();
+
+    /**
+     * @brief Reverses the byte order of every value in a buffer in place
+     * @note Uses SSE2 or AVX2 if the CPU supports them
+     * @param data Buffer holding the values
+     * @param valueSize Size of a single value, either 1, 2, 4 or 8 bytes
+     * @param count Number of values
+     */
+    void swapByteOrder(void *data, size_t valueSize, size_t count);
+
+    /**
+     * @brief Reverses the byte order of every value in a buffer in place using a specific code path
+     * @param instructionSet Code path to use, needs to be one of getSupportedInstructionSets()
+     */
+    void swapByteOrder(void *data, size_t valueSize, size_t count, InstructionSet instructionSet);
+
+    /**
+     * @brief Converts every value in a buffer from the given endianness to the native one or back, in place
+     * @param values Values to convert
+     * @param endian Endianness the values are stored in
+     */
+    template<typename T> requires (std::is_trivially_copyable_v<T> && (sizeof(T) == 1 || sizeof(T) == 2 || sizeof(T) == 4 || sizeof(T) == 8))
+    void changeEndianess(std::span<T> values, std::endian endian) {
+        if (sizeof(T) == 1 || endian == std::endian::native)
+            return;
+
+        swapByteOrder(values.data(), sizeof(T), values.size());
+    }
+
     template<typename T, typename... Args>
     void moveToVector(std::vector<T> & buffer, Args &&...rest) {
         buffer.reserve(sizeof...(rest));
@@ -109,6 +153,46 @@ namespace pl::hlp {
 
     [[nodiscard]] float float16ToFloat32(u16 float16);
 
+    /**
+     * @brief Converts a buffer of half precision floats to single precision floats
+     * @note Produces the same results as the single value overload, using SSE2 or AVX2 if the CPU supports them
+     * @param values Native endian half precision floats
+     * @param result Buffer receiving the converted values, needs to be at least as big as values
+     */
+    void float16ToFloat32(std::span<const u16> values, std::span<float> result);
+
+    /**
+     * @brief Converts a buffer of half precision floats to single precision floats using a specific code path
+     * @param instructionSet Code path to use, needs to be one of getSupportedInstructionSets()
+     */
+    void float16ToFloat32(std::span<const u16> values, std::span<float> result, InstructionSet instructionSet);
+
+    enum class ReductionOperation {
+        Sum,
+        Minimum,
+        Maximum,
+        Xor,
+        PopCount
+    };
+
+    /**
+     * @brief Reduces a buffer of unsigned values to a single value
+     * @note Uses AVX2 if the CPU supports it
+     * @param data Buffer holding native endian values
+     * @param valueSize Size of a single value, either 1, 2, 4 or 8 bytes
+     * @param count Number of values
+     * @param operation Operation to reduce the values with. PopCount counts the set bits of all values together
+     * @return Reduced value. Reducing an empty buffer yields the identity of the operation
+     */
+    [[nodiscard]] u128 reduce(const void *data, size_t valueSize, size_t count, ReductionOperation operation);
+
+    /**
+     * @brief Counts how often every byte value occurs in a buffer
+     * @param data Bytes to count
+     * @param histogram Histogram the counts get added to
+     */
+    void addToByteHistogram(std::span<const u8> data, std::array<u64, 256> &histogram);
+
     [[nodiscard]] inline bool containsIgnoreCase(const std::string &a, const std::string &b) {
         auto iter = std::search(a.begin(), a.end(), b.begin(), b.end(), [](char ch1, char ch2) {
             return std::toupper(ch1) == std::toupper(ch2);
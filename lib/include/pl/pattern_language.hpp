@@ -4,15 +4,16 @@
 #include <bit>
 #include <chrono>
 #include <map>
+#include <mutex>
 #include <optional>
 #include <string>
 #include <string_view>
+#include <thread>
 #include <vector>
 #include <filesystem>
 
-#include <IntervalTree.h>
-
 #include <pl/api.hpp>
+#include <pl/helpers/interval_index.hpp>
 
 #include <pl/core/log_console.hpp>
 #include <pl/core/token.hpp>
@@ -41,6 +42,7 @@ namespace pl {
     namespace ptrn {
         class Pattern;
         class Iteratable;
+        enum class Visibility : u8;
     }
 
     class PatternLanguage {
@@ -59,6 +61,31 @@ namespace pl {
             core::Evaluator       *evaluator;
         };
 
+        /**
+         * @brief Controls when the address index used to look up patterns by address gets built
+         */
+        enum class AddressIndexMode {
+            Eager,          // Built at the end of executeString()
+            Lazy,           // Built by the first lookup
+            Background      // Built on a separate thread once evaluation finished. Lookups wait for it to finish. Building the
+                            // index only reads the patterns, so they can be formatted and iterated while it's running
+        };
+
+        /**
+         * @brief Range of bytes covered by the same set of patterns
+         */
+        struct PatternSpan {
+            struct Entry {
+                ptrn::Pattern *pattern;
+                u64 offset;
+                u32 color;
+                ptrn::Visibility visibility;
+            };
+
+            u64 start, end;
+            std::vector<Entry> patterns;
+        };
+
         [[nodiscard]] std::optional<std::vector<std::shared_ptr<core::ast::ASTNode>>> parseString(const std::string &code);
         [[nodiscard]] bool executeString(std::string string, const std::map<std::string, core::Token::Literal> &envVars = {}, const std::map<std::string, core::Token::Literal> &inVariables = {}, bool checkResult = true);
         [[nodiscard]] bool executeFile(const std::filesystem::path &path, const std::map<std::string, core::Token::Literal> &envVars = {}, const std::map<std::string, core::Token::Literal> &inVariables = {}, bool checkResult = true);
@@ -68,11 +95,51 @@ namespace pl {
 
         void abort();
 
+        /**
+         * @brief Brings the results up to date after bytes of the data source were modified in place
+         * @note Every read done while evaluating is tracked. If none of the modified bytes were read, the patterns and the address index are kept
+         * and only the cached values of the patterns covering them are cleared. Otherwise the last code is executed again.
+         * Formatter functions reading data outside of their own pattern may keep showing old values until then
+         * @param address Address of the first modified byte
+         * @param size Number of modified bytes
+         * @return True if the results are up to date, false if there was nothing to update or executing the code again failed
+         */
+        bool notifyDataModified(u64 address, size_t size);
+
+        /**
+         * @brief Uses a function reading from an address as data source
+         * @note Patterns can be read from multiple threads at once while formatting in parallel. Calls to the read and write
+         * functions are made one at a time, so they don't need to be thread-safe
+         * @param baseAddress Address of the first byte of the data
+         * @param size Size of the data
+         * @param readFunction Function reading data at an address into a buffer
+         * @param writerFunction Function writing data from a buffer to an address
+         */
         void setDataSource(u64 baseAddress, u64 size, std::function<void(u64, u8*, size_t)> readFunction, std::optional<std::function<void(u64, const u8*, size_t)>> writerFunction = std::nullopt) const;
+
+        /**
+         * @brief Uses a non-seekable stream, such as a pipe or a socket, as data source
+         * @note Data is pulled from the stream as evaluation advances and only the last windowSize bytes are kept around.
+         * Reading further back than that fails. The data size is unbounded until the end of the stream is reached.
+         * Use setPatternSink() to process patterns while their data is still available
+         * @param readFunction Function reading the next chunk of the stream into a buffer. Returns the number of bytes read or zero at the end of the stream
+         * @param windowSize Number of bytes to keep around for reading backwards
+         */
+        void setStreamDataSource(std::function<size_t(u8*, size_t)> readFunction, size_t windowSize = 16 * 1024 * 1024) const;
         void setDataBaseAddress(u64 baseAddress) const;
         void setDataSize(u64 size) const;
         void setDefaultEndian(std::endian endian);
         void setStartAddress(u64 address);
+        void setAddressIndexMode(AddressIndexMode mode);
+
+        /**
+         * @brief Enables incremental evaluation of data that only ever grows at its end, such as journals or capture files
+         * @note If the last top-level pattern is a while-sized or unsized array, an incomplete last entry is left out instead of
+         * causing an error. Executing the same code again after the data size grew then only evaluates the new entries of that
+         * array and runs the main function again instead of starting over
+         * @param enabled Whether to enable append mode
+         */
+        void setAppendMode(bool enabled);
 
 
         void addPragma(const std::string &name, const api::PragmaHandler &callback) const;
@@ -81,6 +148,15 @@ namespace pl {
         void setIncludePaths(std::vector<std::fs::path> paths) const;
         void setDangerousFunctionCallHandler(std::function<bool()> callback) const;
 
+        /**
+         * @brief Sets a sink that receives every top-level pattern as soon as it's complete
+         * @note Patterns the sink releases don't show up in the results and can't be referenced by code that runs after them.
+         * Releasing everything keeps memory usage bounded when processing large inputs
+         * @param sink Sink to call or nullptr to keep all patterns
+         * @param includeArrayEntries Also pass each entry of top-level dynamic arrays to the sink before the array itself
+         */
+        void setPatternSink(api::PatternSink sink, bool includeArrayEntries = false) const;
+
         [[nodiscard]] const std::vector<std::pair<core::LogConsole::Level, std::string>> &getConsoleLog() const;
         [[nodiscard]] const std::optional<core::err::PatternLanguageError> &getError() const;
         [[nodiscard]] std::map<std::string, core::Token::Literal> getOutVariables() const;
@@ -92,8 +168,35 @@ namespace pl {
         [[nodiscard]] const std::map<u64, api::Section>& getSections() const;
 
         [[nodiscard]] const std::vector<std::shared_ptr<ptrn::Pattern>> &getAllPatterns(u64 section = 0x00) const;
+
+        /**
+         * @brief Gets all patterns at an address
+         * @note The returned patterns are moved to the address and their format cache is cleared. Use findPatternsAtAddress() to look up patterns from multiple threads
+         * @param address Address to search at
+         * @param section Section to search in
+         * @return Patterns at the address
+         */
         [[nodiscard]] std::vector<ptrn::Pattern *> getPatternsAtAddress(u64 address, u64 section = 0x00) const;
 
+        /**
+         * @brief Gets all patterns at an address without modifying them
+         * @note Safe to call from multiple threads at once. Use Pattern::getFormattedValueAt() and Pattern::forEachChildAt() with the returned offsets to inspect the patterns
+         * @param address Address to search at
+         * @param section Section to search in
+         * @return Patterns at the address together with the offset they're located at
+         */
+        [[nodiscard]] std::vector<PatternSpan::Entry> findPatternsAtAddress(u64 address, u64 section = 0x00) const;
+
+        /**
+         * @brief Gets all patterns in an address range in a single pass
+         * @note Patterns aren't moved to the queried address. Use the offset stored in each entry instead of Pattern::getOffset(). Safe to call from multiple threads at once
+         * @param start Start address of the range
+         * @param end End address of the range, inclusive
+         * @param section Section to search in
+         * @return Consecutive runs of bytes covered by the same patterns, in address order. Bytes without any patterns are left out
+         */
+        [[nodiscard]] std::vector<PatternSpan> getPatternsInRange(u64 start, u64 end, u64 section = 0x00) const;
+
         void reset();
         [[nodiscard]] bool isRunning() const { return this->m_running; }
         [[nodiscard]] const std::chrono::duration<double> & getLastRunningTime() const { return this->m_runningTime; }
@@ -110,7 +213,37 @@ namespace pl {
         }
 
     private:
-        void flattenPatterns();
+        struct FlattenedArray;
+
+        struct FlattenedPattern {
+            ptrn::Pattern *pattern;
+            std::shared_ptr<const FlattenedArray> array;
+        };
+
+        using FlattenedPatterns = hlp::IntervalIndex<FlattenedPattern>;
+
+        /**
+         * @brief Static array that's indexed as a single interval. Addresses are resolved to the patterns of
+         * the first entry by subtracting a multiple of the stride
+         */
+        struct FlattenedArray {
+            u64 stride;
+            FlattenedPatterns entryPatterns;
+        };
+
+        const std::map<u64, FlattenedPatterns> &getFlattenedPatterns() const;
+        void flattenPatterns() const;
+        bool flattenChildren(const std::vector<std::pair<u64, ptrn::Pattern*>> &children, std::vector<FlattenedPatterns::Interval> &intervals) const;
+        void joinFlattenThread();
+        void clearResults();
+
+        struct FoundPattern {
+            u64 start, end;
+            ptrn::Pattern *pattern;
+        };
+
+        static void findFlattenedPatterns(const FlattenedPatterns &patterns, u64 start, u64 end, u64 shift, std::vector<FoundPattern> &results);
+        static void clearFormatCaches(const FlattenedPatterns &patterns, u64 start, u64 end);
 
     private:
 
@@ -119,7 +252,23 @@ namespace pl {
 
         std::vector<std::shared_ptr<core::ast::ASTNode>> m_currAST;
         std::map<u64, std::vector<std::shared_ptr<ptrn::Pattern>>> m_patterns;
-        std::map<u64, interval_tree::IntervalTree<u64, ptrn::Pattern*>> m_flattenedPatterns;
+        // The address index is built on demand, see AddressIndexMode
+        mutable std::map<u64, FlattenedPatterns> m_flattenedPatterns;
+        mutable std::atomic<bool> m_flattened = false;
+        mutable std::mutex m_flattenMutex;
+        std::thread m_flattenThread;
+        AddressIndexMode m_addressIndexMode = AddressIndexMode::Eager;
+
+        struct ExecutionInputs {
+            std::string code;
+            std::map<std::string, core::Token::Literal> envVars, inVariables;
+            bool checkResult;
+
+            bool operator==(const ExecutionInputs &) const = default;
+        };
+
+        bool m_appendMode = false;
+        std::optional<ExecutionInputs> m_lastExecution;
         std::vector<std::function<void(PatternLanguage&)>> m_cleanupCallbacks;
 
         bool m_running = false;
@@ -5,12 +5,15 @@
 #include <pl/pattern_visitor.hpp>
 #include <pl/helpers/types.hpp>
 #include <pl/helpers/utils.hpp>
+#include <pl/helpers/symbol.hpp>
+#include <pl/helpers/arena.hpp>
 
 #include <fmt/format.h>
 
 #include <wolv/utils/core.hpp>
 #include <wolv/utils/guards.hpp>
 
+#include <mutex>
 #include <string>
 
 namespace pl::ptrn {
@@ -59,14 +62,15 @@ namespace pl::ptrn {
         Pattern(const Pattern &other) {
             this->m_evaluator = other.m_evaluator;
             this->m_offset = other.m_offset;
-            this->m_endian = other.m_endian;
+            this->m_hasEndian = other.m_hasEndian;
+            this->m_bigEndian = other.m_bigEndian;
             this->m_size = other.m_size;
             this->m_color = other.m_color;
             this->m_manualColor = other.m_manualColor;
             this->m_section = other.m_section;
             this->m_initialized = other.m_initialized;
             this->m_constant = other.m_constant;
-            this->m_variableName = other.m_variableName;
+            this->copyVariableName(other);
             this->m_typeName = other.m_typeName;
 
             if (other.m_cachedDisplayValue != nullptr)
@@ -80,11 +84,16 @@ namespace pl::ptrn {
         }
 
         virtual ~Pattern() {
+            this->clearVariableName();
+
             if (this->m_evaluator != nullptr) {
                 this->m_evaluator->patternDestroyed(this);
             }
         }
 
+        static void* operator new(size_t size) { return hlp::Arena::allocate(size); }
+        static void operator delete(void *pointer, size_t size) { hlp::Arena::deallocate(pointer, size); }
+
         virtual std::unique_ptr<Pattern> clone() const = 0;
 
         [[nodiscard]] u64 getOffset() const { return this->m_offset; }
@@ -99,14 +108,84 @@ namespace pl::ptrn {
         void setSize(size_t size) { this->m_size = size; }
 
         [[nodiscard]] std::string getVariableName() const {
-            if (this->m_variableName.empty())
-                return fmt::format("{} @ 0x{:02X}", this->getTypeName(), this->getOffset());
+            std::string name;
+            if (this->m_nameKind == NameKind::ArrayIndex)
+                name = fmt::format("[{}]", this->m_arrayIndex);
+            else if (this->m_nameKind == NameKind::Placement)
+                name = fmt::format("{} @ 0x{:02X}", this->m_placementName->typeName.get(), this->m_placementName->offset);
+            else if (this->m_variableName.empty())
+                name = fmt::format("{} @ 0x{:02X}", this->getTypeName(), this->getOffset());
             else
-                return this->m_variableName;
+                name = this->m_variableName.get();
+
+            for (u8 i = 0; i < this->m_dereferenceDepth; i++)
+                name = fmt::format("*({})", name);
+
+            return name;
         }
-        void setVariableName(const std::string &name) {
-            if (!name.empty())
-                this->m_variableName = name;
+        virtual void setVariableName(const std::string &name) {
+            if (!name.empty()) {
+                this->clearVariableName();
+                this->m_variableName = hlp::Symbol(name);
+                this->m_dereferenceDepth = 0;
+            }
+        }
+
+        /**
+         * @brief Names the pattern after its index in the surrounding array
+         * @note The "[index]" string is only generated when the name is requested
+         * @param index Array index
+         */
+        virtual void setArrayIndexName(u64 index) {
+            this->clearVariableName();
+            this->m_arrayIndex = index;
+            this->m_nameKind = NameKind::ArrayIndex;
+            this->m_dereferenceDepth = 0;
+        }
+
+        /**
+         * @brief Names the pattern after the pointer pointing at it
+         * @note The "*(name)" string is only generated when the name is requested. Pointers without a name are named
+         * after their type and offset, which get stored for that
+         * @param pointer Pointer pattern
+         */
+        virtual void setDereferencedName(const Pattern &pointer) {
+            if (pointer.m_nameKind == NameKind::Variable && pointer.m_variableName.empty()) {
+                this->clearVariableName();
+                this->m_placementName = new PlacementName { pointer.m_typeName, pointer.getOffset() };
+                this->m_nameKind = NameKind::Placement;
+                this->m_dereferenceDepth = 1;
+                return;
+            }
+
+            Pattern::copyVariableName(pointer);
+            this->m_dereferenceDepth = pointer.m_dereferenceDepth + 1;
+        }
+
+        /**
+         * @brief Gives the pattern the same name as another pattern
+         * @note Unlike setVariableName(other.getVariableName()) this never generates or interns a new name string
+         * @param other Pattern to copy the name from
+         */
+        virtual void copyVariableName(const Pattern &other) {
+            if (this == &other || (other.m_nameKind == NameKind::Variable && other.m_variableName.empty()))
+                return;
+
+            this->clearVariableName();
+            switch (other.m_nameKind) {
+                case NameKind::Variable:
+                    this->m_variableName = other.m_variableName;
+                    break;
+                case NameKind::ArrayIndex:
+                    this->m_arrayIndex = other.m_arrayIndex;
+                    break;
+                case NameKind::Placement:
+                    this->m_placementName = new PlacementName(*other.m_placementName);
+                    break;
+            }
+
+            this->m_nameKind = other.m_nameKind;
+            this->m_dereferenceDepth = other.m_dereferenceDepth;
         }
 
         [[nodiscard]] std::string getComment() const {
@@ -122,12 +201,12 @@ namespace pl::ptrn {
         }
 
         [[nodiscard]] virtual std::string getTypeName() const {
-            return this->m_typeName;
+            return this->m_typeName.get();
         }
 
         void setTypeName(const std::string &name) {
             if (!name.empty())
-                this->m_typeName = name;
+                this->m_typeName = hlp::Symbol(name);
         }
 
         [[nodiscard]] u32 getColor() const { return this->m_color; }
@@ -145,14 +224,15 @@ namespace pl::ptrn {
 
         [[nodiscard]] std::endian getEndian() const {
             if (this->m_evaluator == nullptr) return std::endian::native;
-            else return this->m_endian.value_or(this->m_evaluator->getDefaultEndian());
+            else return this->getOverriddenEndian().value_or(this->m_evaluator->getDefaultEndian());
         }
         virtual void setEndian(std::endian endian) {
             if (this->isLocal()) return;
 
-            this->m_endian = endian;
+            this->m_hasEndian = true;
+            this->m_bigEndian = endian == std::endian::big;
         }
-        [[nodiscard]] bool hasOverriddenEndian() const { return this->m_endian.has_value(); }
+        [[nodiscard]] bool hasOverriddenEndian() const { return this->m_hasEndian; }
 
         [[nodiscard]] std::string getDisplayName() const {
             if (const auto &arguments = this->getAttributeArguments("name"); !arguments.empty())
@@ -191,33 +271,40 @@ namespace pl::ptrn {
                 return *this->m_cachedDisplayValue;
 
             try {
-                auto &currOffset = this->m_evaluator->dataOffset();
-                auto startOffset = currOffset;
-                currOffset = this->getOffset();
-
-                auto savedScope = this->m_evaluator->getScope(0);
-
-                ON_SCOPE_EXIT {
-                    this->m_evaluator->getScope(0) = savedScope;
-                    currOffset = startOffset;
-                };
-
-                return this->formatDisplayValue();
+                return this->formatValue(this->getOffset());
             } catch(std::exception &e) {
                 this->m_cachedDisplayValue = std::make_unique<std::string>(e.what());
                 return *this->m_cachedDisplayValue;
             }
         }
 
+        /**
+         * @brief Formats the value of the pattern as if it was placed at the given offset
+         * @note Neither the pattern nor its format cache get modified so this may be called from multiple threads at once after evaluation finished
+         * @param offset Offset to format the pattern at
+         * @return Formatted value
+         */
+        [[nodiscard]] std::string getFormattedValueAt(u64 offset) {
+            try {
+                return this->formatValue(offset);
+            } catch(std::exception &e) {
+                return e.what();
+            }
+        }
+
         [[nodiscard]] virtual std::string toString() const {
             auto result = fmt::format("{} {} @ 0x{:X}", this->getTypeName(), this->getVariableName(), this->getOffset());
 
             return this->formatDisplayValue(result, this->getValue());
         }
 
+        /**
+         * @brief Gets the value of the pattern. Non-primitive patterns are passed on as a pointer to themselves
+         * @note The returned pattern pointer is borrowed and only valid as long as this pattern is alive
+         * @return Value of the pattern
+         */
         [[nodiscard]] virtual core::Token::Literal getValue() const {
-            auto clone = this->clone();
-            return this->transformValue(clone.get());
+            return this->transformValue(const_cast<Pattern*>(this));
         }
 
         [[nodiscard]] virtual std::vector<std::pair<u64, Pattern*>> getChildren() {
@@ -227,6 +314,25 @@ namespace pl::ptrn {
                 return { { this->getOffset(), this } };
         }
 
+        /**
+         * @brief Gets the children of the pattern for the address index
+         * @note Works like getChildren() but static arrays are returned as a single child instead of one per entry
+         * @return Children of the pattern
+         */
+        [[nodiscard]] virtual std::vector<std::pair<u64, Pattern*>> getIndexChildren() {
+            return this->getChildren();
+        }
+
+        /**
+         * @brief Calls a function for each direct child of the pattern as if the pattern was placed at the given offset
+         * @note Neither the pattern nor the evaluator get modified so this may be called from multiple threads at once after evaluation finished
+         * @param offset Offset of this pattern
+         * @param callback Function called with the offset and the pattern of each child
+         */
+        virtual void forEachChildAt(u64 offset, const std::function<void(u64, const Pattern*)> &callback) const {
+            wolv::util::unused(offset, callback);
+        }
+
         void setVisibility(Visibility visibility) {
             switch (visibility) {
                 case Visibility::Visible:
@@ -356,6 +462,7 @@ namespace pl::ptrn {
                 try {
                     const auto function = this->m_evaluator->findFunction(formatterFunctionName);
                     if (function.has_value()) {
+                        std::scoped_lock lock(this->m_evaluator->getFunctionCallMutex());
                         auto formatterResult = function->func(this->m_evaluator, { value });
 
                         if (formatterResult.has_value()) {
@@ -373,17 +480,12 @@ namespace pl::ptrn {
             }
         }
 
-        void clearFormatCache() {
-            if (this->m_cachedDisplayValue == nullptr)
-                return;
-
+        /**
+         * @brief Forgets the formatted value of the pattern and all of its children
+         * @note Children are always cleared, even if the pattern itself hasn't been formatted yet
+         */
+        virtual void clearFormatCache() {
             this->m_cachedDisplayValue.reset();
-
-            if (auto *iteratable = dynamic_cast<Iteratable*>(this); iteratable != nullptr) {
-                for (auto &entry : iteratable->getEntries()) {
-                    entry->clearFormatCache();
-                }
-            }
         }
 
         virtual void accept(PatternVisitor &v) = 0;
@@ -444,19 +546,36 @@ namespace pl::ptrn {
 
 
     protected:
-        std::optional<std::endian> m_endian;
-
         [[nodiscard]] core::Token::Literal transformValue(const core::Token::Literal &value) const {
             auto evaluator = this->getEvaluator();
-            if (auto transformFunc = evaluator->findFunction(this->getTransformFunction()); transformFunc.has_value())
+            if (auto transformFunc = evaluator->findFunction(this->getTransformFunction()); transformFunc.has_value()) {
+                std::scoped_lock lock(evaluator->getFunctionCallMutex());
                 if (auto result = transformFunc->func(evaluator, { value }); result.has_value())
                     return *result;
+            }
 
             return value;
         }
 
         [[nodiscard]] virtual std::string formatDisplayValue() = 0;
 
+        /**
+         * @brief Formats the value of the pattern as if it was placed at the given offset
+         * @note Leaf patterns override this to read their value from the offset directly. Everything else has children that
+         * need to move along, so it gets formatted through a copy placed at the offset
+         * @param offset Offset to format the pattern at
+         * @return Formatted value
+         */
+        [[nodiscard]] virtual std::string formatDisplayValueAt(u64 offset) {
+            if (offset == this->getOffset())
+                return this->formatDisplayValue();
+
+            auto pattern = this->clone();
+            pattern->setOffset(offset);
+
+            return pattern->formatDisplayValue();
+        }
+
         [[nodiscard]] std::string formatDisplayValue(const std::string &value, const core::Token::Literal &literal) const {
             const auto &formatterFunctionName = this->getReadFormatterFunction();
             if (formatterFunctionName.empty())
@@ -465,6 +584,7 @@ namespace pl::ptrn {
                 try {
                     const auto function = this->m_evaluator->findFunction(formatterFunctionName);
                     if (function.has_value()) {
+                        std::scoped_lock lock(this->m_evaluator->getFunctionCallMutex());
                         auto result = function->func(this->m_evaluator, { literal });
 
                         if (result.has_value()) {
@@ -484,16 +604,71 @@ namespace pl::ptrn {
 
         template<typename T>
         [[nodiscard]] bool compareCommonProperties(const Pattern &other) const {
+            const auto thisEndian  = this->getOverriddenEndian();
+            const auto otherEndian = other.getOverriddenEndian();
+
             return typeid(other) == typeid(std::remove_cvref_t<T>) &&
                    this->m_offset == other.m_offset &&
                    this->m_size == other.m_size &&
                    (this->m_attributes == nullptr || other.m_attributes == nullptr || *this->m_attributes == *other.m_attributes) &&
-                   (this->m_endian == other.m_endian || (!this->m_endian.has_value() && other.m_endian == std::endian::native) || (!other.m_endian.has_value() && this->m_endian == std::endian::native)) &&
-                   this->m_variableName == other.m_variableName &&
+                   (thisEndian == otherEndian || (!thisEndian.has_value() && otherEndian == std::endian::native) || (!otherEndian.has_value() && thisEndian == std::endian::native)) &&
+                   this->hasSameVariableName(other) &&
                    this->m_typeName == other.m_typeName &&
                    this->m_section == other.m_section;
         }
 
+    private:
+        [[nodiscard]] std::optional<std::endian> getOverriddenEndian() const {
+            if (!this->m_hasEndian)
+                return std::nullopt;
+            else
+                return this->m_bigEndian ? std::endian::big : std::endian::little;
+        }
+
+        [[nodiscard]] bool hasSameVariableName(const Pattern &other) const {
+            if (this->m_dereferenceDepth != other.m_dereferenceDepth || this->m_nameKind != other.m_nameKind)
+                return this->getVariableName() == other.getVariableName();
+
+            switch (this->m_nameKind) {
+                case NameKind::ArrayIndex:
+                    return this->m_arrayIndex == other.m_arrayIndex;
+                case NameKind::Placement:
+                    return this->m_placementName->typeName == other.m_placementName->typeName && this->m_placementName->offset == other.m_placementName->offset;
+                default:
+                    return this->m_variableName == other.m_variableName;
+            }
+        }
+
+        // Frees the stored name and leaves the pattern without one
+        void clearVariableName() {
+            if (this->m_nameKind == NameKind::Placement)
+                delete this->m_placementName;
+
+            this->m_variableName = { };
+            this->m_nameKind = NameKind::Variable;
+        }
+
+        [[nodiscard]] std::string formatValue(u64 offset) {
+            // Only formatter and transform functions depend on the evaluator's state
+            if (!this->hasAttribute("format_read") && !this->hasAttribute("transform"))
+                return this->formatDisplayValueAt(offset);
+
+            std::scoped_lock lock(this->m_evaluator->getFunctionCallMutex());
+
+            auto &currOffset = this->m_evaluator->dataOffset();
+            auto startOffset = currOffset;
+            currOffset = offset;
+
+            auto savedScope = this->m_evaluator->getScope(0);
+
+            ON_SCOPE_EXIT {
+                this->m_evaluator->getScope(0) = savedScope;
+                currOffset = startOffset;
+            };
+
+            return this->formatDisplayValueAt(offset);
+        }
+
     private:
         friend pl::core::Evaluator;
 
@@ -502,8 +677,25 @@ namespace pl::ptrn {
         std::unique_ptr<std::map<std::string, std::vector<core::Token::Literal>>> m_attributes;
         mutable std::unique_ptr<std::string> m_cachedDisplayValue;
 
-        std::string m_variableName;
-        std::string m_typeName;
+        struct PlacementName {
+            hlp::Symbol typeName;
+            u64 offset;
+        };
+
+        enum class NameKind : u8 {
+            Variable,
+            ArrayIndex,
+            Placement
+        };
+
+        // Array entries store their index instead of a "[index]" name string, see m_nameKind.
+        // Patterns pointed at by pointers store the pointer's name and how many "*()" to wrap it in, see m_dereferenceDepth
+        union {
+            hlp::Symbol m_variableName = { };
+            u64 m_arrayIndex;
+            PlacementName *m_placementName;
+        };
+        hlp::Symbol m_typeName;
 
         u64 m_offset  = 0x00;
         size_t m_size = 0x00;
@@ -511,11 +703,15 @@ namespace pl::ptrn {
 
         u32 m_color = 0x00;
 
-        bool m_reference = false;
-        bool m_constant = false;
-        bool m_initialized = false;
+        bool m_reference      : 1 = false;
+        bool m_constant       : 1 = false;
+        bool m_initialized    : 1 = false;
+        bool m_manualColor    : 1 = false;
+        bool m_hasEndian      : 1 = false;
+        bool m_bigEndian      : 1 = false;
+        NameKind m_nameKind   : 2 = NameKind::Variable;
 
-        bool m_manualColor = false;
+        u8 m_dereferenceDepth = 0;
     };
 
 }
\ No newline at end of file
@@ -1,6 +1,7 @@
 #pragma once
 
 #include <pl/patterns/pattern.hpp>
+#include <pl/patterns/pattern_array_values.hpp>
 
 namespace pl::ptrn {
 
@@ -11,13 +12,7 @@ namespace pl::ptrn {
         PatternArrayDynamic(core::Evaluator *evaluator, u64 offset, size_t size)
             : Pattern(evaluator, offset, size) { }
 
-        PatternArrayDynamic(const PatternArrayDynamic &other) : Pattern(other) {
-            std::vector<std::shared_ptr<Pattern>> entries;
-            for (const auto &entry : other.m_entries)
-                entries.push_back(entry->clone());
-
-            this->setEntries(std::move(entries));
-        }
+        PatternArrayDynamic(const PatternArrayDynamic &other) : Pattern(other), m_entries(other.m_entries) { }
 
         [[nodiscard]] std::unique_ptr<Pattern> clone() const override {
             return std::unique_ptr<Pattern>(new PatternArrayDynamic(*this));
@@ -25,34 +20,42 @@ namespace pl::ptrn {
 
         void setColor(u32 color) override {
             Pattern::setColor(color);
-            for (auto &entry : this->m_entries)
+            for (auto &entry : this->m_entries.entries)
                 if (!entry->hasOverriddenColor())
                     entry->setColor(color);
         }
 
+        void clearFormatCache() override {
+            Pattern::clearFormatCache();
+            for (const auto &entry : this->m_entries.entries)
+                entry->clearFormatCache();
+        }
+
         [[nodiscard]] std::string getFormattedName() const override {
-            if (this->m_entries.empty())
+            const auto &entries = this->m_entries.entries;
+            if (entries.empty())
                 return "???";
 
-            return this->m_entries.front()->getTypeName() + "[" + std::to_string(this->m_entries.size()) + "]";
+            return entries.front()->getTypeName() + "[" + std::to_string(entries.size()) + "]";
         }
 
         [[nodiscard]] std::string getTypeName() const override {
-            if (this->m_entries.empty())
+            const auto &entries = this->m_entries.entries;
+            if (entries.empty())
                 return "???";
 
-            return this->m_entries.front()->getTypeName();
+            return entries.front()->getTypeName();
         }
 
         void setOffset(u64 offset) override {
-            for (auto &entry : this->m_entries)
+            for (auto &entry : this->m_entries.entries)
                 entry->setOffset(entry->getOffset() - this->getOffset() + offset);
 
             Pattern::setOffset(offset);
         }
 
         void setSection(u64 id) override {
-            for (auto &entry : this->m_entries)
+            for (auto &entry : this->m_entries.entries)
                 entry->setSection(id);
 
             Pattern::setSection(id);
@@ -61,7 +64,7 @@ namespace pl::ptrn {
         [[nodiscard]] std::vector<std::pair<u64, Pattern*>> getChildren() override {
             std::vector<std::pair<u64, Pattern*>> result;
 
-            for (const auto &entry : this->m_entries) {
+            for (const auto &entry : this->m_entries.entries) {
                 auto children = entry->getChildren();
                 std::copy(children.begin(), children.end(), std::back_inserter(result));
             }
@@ -69,30 +72,48 @@ namespace pl::ptrn {
             return result;
         }
 
+        [[nodiscard]] std::vector<std::pair<u64, Pattern*>> getIndexChildren() override {
+            std::vector<std::pair<u64, Pattern*>> result;
+
+            for (const auto &entry : this->m_entries.entries) {
+                auto children = entry->getIndexChildren();
+                std::copy(children.begin(), children.end(), std::back_inserter(result));
+            }
+
+            return result;
+        }
+
+        void forEachChildAt(u64 offset, const std::function<void(u64, const Pattern*)> &callback) const override {
+            for (const auto &entry : this->m_entries.entries) {
+                if (!entry->isPatternLocal())
+                    callback(entry->getOffset() - this->getOffset() + offset, entry.get());
+            }
+        }
+
         void setLocal(bool local) override {
-            for (auto &pattern : this->m_entries)
+            for (auto &pattern : this->m_entries.entries)
                 pattern->setLocal(local);
 
             Pattern::setLocal(local);
         }
 
         void setReference(bool reference) override {
-            for (auto &pattern : this->m_entries)
+            for (auto &pattern : this->m_entries.entries)
                 pattern->setReference(reference);
 
             Pattern::setReference(reference);
         }
 
         [[nodiscard]] std::shared_ptr<Pattern> getEntry(size_t index) const override {
-            return this->m_entries[index];
+            return this->m_entries.entries[index];
         }
 
         [[nodiscard]] size_t getEntryCount() const override {
-            return this->m_entries.size();
+            return this->m_entries.entries.size();
         }
 
         [[nodiscard]] std::vector<std::shared_ptr<Pattern>> getEntries() override {
-            return this->m_entries;
+            return this->m_entries.entries;
         }
 
         void forEachEntry(u64 start, u64 end, const std::function<void(u64, Pattern*)>& fn) override {
@@ -106,23 +127,61 @@ namespace pl::ptrn {
                     evaluator->clearCurrentArrayIndex();
             };
 
-            for (u64 i = start; i < std::min<u64>(end, this->m_entries.size()); i++) {
+            const auto &entries = this->m_entries.entries;
+            for (u64 i = start; i < std::min<u64>(end, entries.size()); i++) {
                 evaluator->setCurrentArrayIndex(i);
-                if (!this->m_entries[i]->isPatternLocal())
-                    fn(i, this->m_entries[i].get());
+                if (!entries[i]->isPatternLocal())
+                    fn(i, entries[i].get());
             }
         }
 
+        /**
+         * @brief Copies the values of a range of entries into a buffer using a single read
+         * @note Only supported if all entries in the range are integers, enums, characters or floats of the same
+         * type, exactly as big as T and laid out back to back. Half precision floats can be read as float
+         * @param start Index of the first entry
+         * @param values Buffer to fill, one value per entry
+         * @return False if the entries can't be read as T or the range is out of bounds, in which case the buffer is left untouched
+         */
+        template<typename T>
+        [[nodiscard]] bool readValues(u64 start, std::span<T> values) const {
+            const auto &entries = this->m_entries.entries;
+            if (start > entries.size() || values.size() > entries.size() - start)
+                return false;
+            if (values.empty())
+                return true;
+
+            const auto &first = *entries[start];
+            if (!isBulkReadableAs<T>(&first))
+                return false;
+
+            const auto entrySize = first.getSize();
+            for (u64 i = 1; i < values.size(); i++) {
+                const auto &entry = *entries[start + i];
+                if (typeid(entry) != typeid(first) || entry.getOffset() != first.getOffset() + i * entrySize ||
+                    entry.getSize() != entrySize || entry.getEndian() != first.getEndian() || entry.getSection() != first.getSection() ||
+                    !entry.getTransformFunction().empty())
+                    return false;
+            }
+
+            readBulkValues(&first, first.getOffset(), values);
+
+            return true;
+        }
+
         void setEntries(std::vector<std::shared_ptr<Pattern>> &&entries) {
-            this->m_entries = std::move(entries);
+            this->m_entries = { };
 
-            for (auto &entry : this->m_entries) {
+            auto &ownEntries = this->m_entries.entries;
+            ownEntries = std::move(entries);
+
+            for (auto &entry : ownEntries) {
                 if (!entry->hasOverriddenColor())
                     entry->setBaseColor(this->getColor());
             }
 
-            if (!this->m_entries.empty())
-                this->setBaseColor(this->m_entries.front()->getColor());
+            if (!ownEntries.empty())
+                this->setBaseColor(ownEntries.front()->getColor());
         }
 
         [[nodiscard]] std::string toString() const override {
@@ -131,7 +190,7 @@ namespace pl::ptrn {
             result += "[ ";
 
             size_t entryCount = 0;
-            for (const auto &entry : this->m_entries) {
+            for (const auto &entry : this->m_entries.entries) {
                 if (entryCount > 50) {
                     result += fmt::format("..., ");
                     break;
@@ -149,7 +208,7 @@ namespace pl::ptrn {
 
             result += " ]";
 
-            return Pattern::formatDisplayValue(result, this->clone().get());
+            return Pattern::formatDisplayValue(result, const_cast<PatternArrayDynamic*>(this));
         }
 
         [[nodiscard]] bool operator==(const Pattern &other) const override {
@@ -157,11 +216,13 @@ namespace pl::ptrn {
                 return false;
 
             auto &otherArray = *static_cast<const PatternArrayDynamic *>(&other);
-            if (this->m_entries.size() != otherArray.m_entries.size())
+            const auto &entries = this->m_entries.entries;
+            const auto &otherEntries = otherArray.m_entries.entries;
+            if (entries.size() != otherEntries.size())
                 return false;
 
-            for (u64 i = 0; i < this->m_entries.size(); i++) {
-                if (*this->m_entries[i] != *otherArray.m_entries[i])
+            for (u64 i = 0; i < entries.size(); i++) {
+                if (*entries[i] != *otherEntries[i])
                     return false;
             }
 
@@ -173,7 +234,7 @@ namespace pl::ptrn {
 
             Pattern::setEndian(endian);
 
-            for (auto &entry : this->m_entries) {
+            for (auto &entry : this->m_entries.entries) {
                 entry->setEndian(endian);
             }
 
@@ -188,7 +249,22 @@ namespace pl::ptrn {
         }
 
     private:
-        std::vector<std::shared_ptr<Pattern>> m_entries;
+        struct Entries {
+            Entries() = default;
+            Entries(const Entries &other) {
+                for (const auto &entry : other.entries)
+                    this->entries.push_back(entry->clone());
+            }
+            Entries(Entries&&) = default;
+
+            Entries &operator=(const Entries&) = delete;
+            Entries &operator=(Entries&&) = default;
+
+            std::vector<std::shared_ptr<Pattern>> entries;
+        };
+
+        // Clones own copies of all entries, so pointers to the entries of one stay valid whatever happens to the other
+        Entries m_entries;
     };
 
 }
\ No newline at end of file
@@ -1,6 +1,7 @@
 #pragma once
 
 #include <pl/patterns/pattern.hpp>
+#include <pl/patterns/pattern_array_values.hpp>
 
 namespace pl::ptrn {
 
@@ -43,14 +44,14 @@ namespace pl::ptrn {
 
             auto &entry = this->m_template;
             for (u64 index = start; index < std::min<u64>(end, this->m_entryCount); index++) {
-                entry->setVariableName(fmt::format("[{0}]", index));
+                entry->setArrayIndexName(index);
                 entry->setOffset(this->getOffset() + index * this->m_template->getSize());
                 evaluator->setCurrentArrayIndex(index);
 
-                if (this->m_formatCache.contains(index))
-                    entry->setFormatValue(this->m_formatCache[index]);
-                else
-                    entry->clearFormatCache();
+                // The children of the template still hold the values of the previous entry
+                entry->clearFormatCache();
+                if (auto cachedValue = this->m_formatCache.find(index); cachedValue != this->m_formatCache.end())
+                    entry->setFormatValue(cachedValue->second);
 
                 fn(index, entry.get());
 
@@ -58,35 +59,109 @@ namespace pl::ptrn {
             }
         }
 
+        /**
+         * @brief Calls a function for each entry in a range using a private copy of the template
+         * @note Unlike forEachEntry() neither the array nor its format cache get modified, so different ranges may be iterated from multiple threads at once
+         * @param start Index of the first entry
+         * @param end Index after the last entry
+         * @param fn Function called with the index and the pattern of each entry
+         */
+        void forEachEntryCopy(u64 start, u64 end, const std::function<void(u64, Pattern*)>& fn) const {
+            auto evaluator = this->getEvaluator();
+            auto startArrayIndex = evaluator->getCurrentArrayIndex();
+            ON_SCOPE_EXIT {
+                if (startArrayIndex.has_value())
+                    evaluator->setCurrentArrayIndex(*startArrayIndex);
+                else
+                    evaluator->clearCurrentArrayIndex();
+            };
+
+            auto entry = this->m_template->clone();
+            for (u64 index = start; index < std::min<u64>(end, this->m_entryCount); index++) {
+                entry->setArrayIndexName(index);
+                entry->setOffset(this->getOffset() + index * this->m_template->getSize());
+                entry->clearFormatCache();
+                evaluator->setCurrentArrayIndex(index);
+
+                fn(index, entry.get());
+            }
+        }
+
+        /**
+         * @brief Copies the values of a range of entries into a buffer using a single read
+         * @note Only arrays of integers, enums, characters and floats whose entries are exactly as big as T are supported.
+         * Arrays of half precision floats can be read as float
+         * @param start Index of the first entry
+         * @param values Buffer to fill, one value per entry
+         * @return False if the entries can't be read as T or the range is out of bounds, in which case the buffer is left untouched
+         */
+        template<typename T>
+        [[nodiscard]] bool readValues(u64 start, std::span<T> values) const {
+            if (start > this->m_entryCount || values.size() > this->m_entryCount - start)
+                return false;
+            if (!isBulkReadableAs<T>(this->m_template.get()))
+                return false;
+
+            readBulkValues(this->m_template.get(), this->getOffset() + start * this->m_template->getSize(), values);
+
+            return true;
+        }
+
         void setOffset(u64 offset) override {
-            this->m_template->setOffset(this->m_template->getOffset() - this->getOffset() + offset);
+            if (this->m_template != nullptr)
+                this->m_template->setOffset(this->m_template->getOffset() - this->getOffset() + offset);
+
+            if (this->m_highlightTemplate != nullptr)
+                this->m_highlightTemplate->setOffset(offset);
 
             Pattern::setOffset(offset);
         }
 
         void setSection(u64 id) override {
-            this->m_template->setSection(id);
+            if (this->m_template != nullptr)
+                this->m_template->setSection(id);
 
-            for (auto &highlightTemplate : this->m_highlightTemplates)
-                highlightTemplate->setSection(id);
+            if (this->m_highlightTemplate != nullptr)
+                this->m_highlightTemplate->setSection(id);
 
             Pattern::setSection(id);
         }
 
+        void setVariableName(const std::string &name) override {
+            Pattern::setVariableName(name);
+
+            if (this->m_highlightTemplate != nullptr)
+                this->m_highlightTemplate->copyVariableName(*this);
+        }
+
+        void setArrayIndexName(u64 index) override {
+            Pattern::setArrayIndexName(index);
+
+            if (this->m_highlightTemplate != nullptr)
+                this->m_highlightTemplate->copyVariableName(*this);
+        }
+
+        void setDereferencedName(const Pattern &pointer) override {
+            Pattern::setDereferencedName(pointer);
+
+            if (this->m_highlightTemplate != nullptr)
+                this->m_highlightTemplate->copyVariableName(*this);
+        }
+
+        void copyVariableName(const Pattern &other) override {
+            Pattern::copyVariableName(other);
+
+            if (this->m_highlightTemplate != nullptr)
+                this->m_highlightTemplate->copyVariableName(*this);
+        }
+
         [[nodiscard]] std::vector<std::pair<u64, Pattern*>> getChildren() override {
             if (this->isSealed())
                 return { { this->getOffset(), this } };
             else {
                 std::vector<std::pair<u64, Pattern*>> result;
 
-                std::shared_ptr<Pattern> highlightTemplate = this->m_template->clone();
-
-                highlightTemplate->setVariableName(this->getVariableName());
-                highlightTemplate->setOffset(this->getOffset());
-
-                this->m_highlightTemplates.push_back(highlightTemplate);
-
-                auto children = highlightTemplate->getChildren();
+                auto children = this->m_highlightTemplate->getChildren();
 
                 result.reserve(this->getEntryCount() * children.size());
 
@@ -101,12 +176,32 @@ namespace pl::ptrn {
             }
         }
 
+        [[nodiscard]] std::vector<std::pair<u64, Pattern*>> getIndexChildren() override {
+            return { { this->getOffset(), this } };
+        }
+
+        void forEachChildAt(u64 offset, const std::function<void(u64, const Pattern*)> &callback) const override {
+            const auto templateSize = this->m_template->getSize();
+            for (u64 index = 0; index < this->m_entryCount; index++)
+                callback(offset + index * templateSize, this->m_template.get());
+        }
+
+        /**
+         * @brief Gets a copy of the template placed at the first entry which can be used for highlighting
+         * @note All other entries are located at multiples of the template size after it. The copy is created once by
+         * setEntries() and kept in sync with the array, so this never modifies the array
+         * @return Highlight template owned by this array
+         */
+        [[nodiscard]] Pattern* getHighlightTemplate() const {
+            return this->m_highlightTemplate.get();
+        }
+
         void setLocal(bool local) override {
             if (this->m_template != nullptr)
                 this->m_template->setLocal(local);
 
-            for (auto &highlightTemplate : this->m_highlightTemplates)
-                highlightTemplate->setLocal(local);
+            if (this->m_highlightTemplate != nullptr)
+                this->m_highlightTemplate->setLocal(local);
 
             Pattern::setLocal(local);
         }
@@ -115,18 +210,45 @@ namespace pl::ptrn {
             if (this->m_template != nullptr)
                 this->m_template->setReference(reference);
 
-            for (auto &highlightTemplate : this->m_highlightTemplates)
-                highlightTemplate->setReference(reference);
+            if (this->m_highlightTemplate != nullptr)
+                this->m_highlightTemplate->setReference(reference);
 
             Pattern::setReference(reference);
         }
 
         void setColor(u32 color) override {
             Pattern::setColor(color);
-            this->m_template->setColor(color);
 
-            for (auto &highlightTemplate : this->m_highlightTemplates)
-                highlightTemplate->setColor(color);
+            if (this->m_template != nullptr)
+                this->m_template->setColor(color);
+
+            if (this->m_highlightTemplate != nullptr)
+                this->m_highlightTemplate->setColor(color);
+        }
+
+        void clearFormatCache() override {
+            this->clearFormatCache(0, this->m_entryCount);
+        }
+
+        /**
+         * @brief Forgets the formatted values of a range of entries after their data changed
+         * @note The formatted value of the array itself is cleared as well since it may depend on any of its entries
+         * @param start Index of the first entry
+         * @param end Index after the last entry
+         */
+        void clearFormatCache(u64 start, u64 end) {
+            Pattern::clearFormatCache();
+
+            if (start == 0 && end >= this->m_entryCount)
+                this->m_formatCache.clear();
+            else
+                this->m_formatCache.erase(this->m_formatCache.lower_bound(start), this->m_formatCache.lower_bound(end));
+
+            if (this->m_template != nullptr)
+                this->m_template->clearFormatCache();
+
+            if (this->m_highlightTemplate != nullptr)
+                this->m_highlightTemplate->clearFormatCache();
         }
 
         [[nodiscard]] std::string getFormattedName() const override {
@@ -154,15 +276,15 @@ namespace pl::ptrn {
 
         void setEntries(std::unique_ptr<Pattern> &&templatePattern, size_t count) {
             this->m_template          = std::move(templatePattern);
-            this->m_highlightTemplates.push_back(this->m_template->clone());
             this->m_entryCount        = count;
 
             this->m_template->setSection(this->getSection());
 
             this->m_template->setBaseColor(this->getColor());
 
-            for (auto &highlightTemplate : this->m_highlightTemplates)
-                highlightTemplate->setBaseColor(this->getColor());
+            this->m_highlightTemplate = this->m_template->clone();
+            this->m_highlightTemplate->copyVariableName(*this);
+            this->m_highlightTemplate->setOffset(this->getOffset());
         }
 
         [[nodiscard]] bool operator==(const Pattern &other) const override {
@@ -178,7 +300,11 @@ namespace pl::ptrn {
 
             Pattern::setEndian(endian);
 
-            this->m_template->setEndian(endian);
+            if (this->m_template != nullptr)
+                this->m_template->setEndian(endian);
+
+            if (this->m_highlightTemplate != nullptr)
+                this->m_highlightTemplate->setEndian(endian);
         }
 
         void accept(PatternVisitor &v) override {
@@ -215,12 +341,12 @@ namespace pl::ptrn {
 
             result += " ]";
 
-            return Pattern::formatDisplayValue(result, this->clone().get());
+            return Pattern::formatDisplayValue(result, const_cast<PatternArrayStatic*>(this));
         }
 
     private:
         std::shared_ptr<Pattern> m_template = nullptr;
-        mutable std::vector<std::shared_ptr<Pattern>> m_highlightTemplates;
+        std::unique_ptr<Pattern> m_highlightTemplate = nullptr;
         size_t m_entryCount = 0;
 
         std::map<u64, std::string> m_formatCache;
@@ -0,0 +1,76 @@
+#pragma once
+
+#include <pl/patterns/pattern.hpp>
+#include <pl/patterns/pattern_character.hpp>
+#include <pl/patterns/pattern_enum.hpp>
+#include <pl/patterns/pattern_float.hpp>
+#include <pl/patterns/pattern_signed.hpp>
+#include <pl/patterns/pattern_unsigned.hpp>
+#include <pl/patterns/pattern_wide_character.hpp>
+
+#include <concepts>
+#include <span>
+#include <vector>
+
+namespace pl::ptrn {
+
+    /**
+     * @brief Checks if the raw bytes of an array entry can be copied straight into a value of type T
+     * @note Entries need to be exactly as big as T and must not have a transform function. Half precision floats
+     * can additionally be read as float
+     * @param entry Entry to check
+     * @return True if the entry holds an integer for integral types or a float for floating point types
+     */
+    template<typename T>
+    [[nodiscard]] bool isBulkReadableAs(const Pattern *entry) {
+        if (entry == nullptr || !entry->getTransformFunction().empty())
+            return false;
+
+        if constexpr (std::same_as<T, float>) {
+            if (entry->getSize() == sizeof(u16))
+                return dynamic_cast<const PatternFloat*>(entry) != nullptr;
+        }
+
+        if (entry->getSize() != sizeof(T))
+            return false;
+
+        if constexpr (std::floating_point<T>) {
+            return dynamic_cast<const PatternFloat*>(entry) != nullptr;
+        } else if constexpr (std::integral<T> && !std::same_as<T, bool>) {
+            return dynamic_cast<const PatternUnsigned*>(entry)      != nullptr ||
+                   dynamic_cast<const PatternSigned*>(entry)        != nullptr ||
+                   dynamic_cast<const PatternEnum*>(entry)          != nullptr ||
+                   dynamic_cast<const PatternCharacter*>(entry)     != nullptr ||
+                   dynamic_cast<const PatternWideCharacter*>(entry) != nullptr;
+        } else {
+            return false;
+        }
+    }
+
+    /**
+     * @brief Reads consecutive entries laid out back to back with a single read and converts them to native endianness
+     * @param entry Any of the entries, used for its section and endianness
+     * @param address Address of the first entry to read
+     * @param values Buffer to fill
+     */
+    template<typename T>
+    void readBulkValues(const Pattern *entry, u64 address, std::span<T> values) {
+        if (values.empty())
+            return;
+
+        if constexpr (std::same_as<T, float>) {
+            if (entry->getSize() == sizeof(u16)) {
+                std::vector<u16> halfs(values.size());
+                entry->getEvaluator()->readData(address, halfs.data(), halfs.size() * sizeof(u16), entry->getSection());
+                hlp::changeEndianess(std::span(halfs), entry->getEndian());
+                hlp::float16ToFloat32(halfs, values);
+
+                return;
+            }
+        }
+
+        entry->getEvaluator()->readData(address, values.data(), values.size_bytes(), entry->getSection());
+        hlp::changeEndianess(values, entry->getEndian());
+    }
+
+}
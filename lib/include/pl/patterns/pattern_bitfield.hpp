@@ -189,6 +189,12 @@ namespace pl::ptrn {
                     entry->setColor(color);
         }
 
+        void clearFormatCache() override {
+            Pattern::clearFormatCache();
+            for (const auto &entry : this->m_entries)
+                entry->clearFormatCache();
+        }
+
         [[nodiscard]] std::string getFormattedName() const override {
             if (this->m_entries.empty())
                 return "???";
@@ -221,6 +227,13 @@ namespace pl::ptrn {
             return result;
         }
 
+        void forEachChildAt(u64 offset, const std::function<void(u64, const Pattern*)> &callback) const override {
+            for (const auto entry : this->m_sortedEntries) {
+                if (!entry->isPatternLocal())
+                    callback(entry->getOffset() - this->getOffset() + offset, entry);
+            }
+        }
+
         void setLocal(bool local) override {
             for (auto &pattern : this->m_entries)
                 pattern->setLocal(local);
@@ -303,7 +316,7 @@ namespace pl::ptrn {
 
             result += " ]";
 
-            return Pattern::formatDisplayValue(result, this->clone().get());
+            return Pattern::formatDisplayValue(result, const_cast<PatternBitfieldArray*>(this));
         }
 
         [[nodiscard]] bool operator==(const Pattern &other) const override {
@@ -432,6 +445,16 @@ namespace pl::ptrn {
             }
         }
 
+        void forEachChildAt(u64 offset, const std::function<void(u64, const Pattern*)> &callback) const override {
+            if (this->isSealed())
+                return;
+
+            for (const auto field : this->m_sortedFields) {
+                if (!field->isPatternLocal())
+                    callback(field->getOffset() - this->getOffset() + offset, field);
+            }
+        }
+
         void setLocal(bool local) override {
             for (auto &pattern : this->m_fields)
                 pattern->setLocal(local);
@@ -446,6 +469,12 @@ namespace pl::ptrn {
             Pattern::setReference(reference);
         }
 
+        void clearFormatCache() override {
+            Pattern::clearFormatCache();
+            for (const auto &field : this->m_fields)
+                field->clearFormatCache();
+        }
+
         [[nodiscard]] std::string getFormattedName() const override {
             return "bitfield " + Pattern::getTypeName();
         }
@@ -507,7 +536,7 @@ namespace pl::ptrn {
 
             result += " }";
 
-            return Pattern::formatDisplayValue(result, this->clone().get());
+            return Pattern::formatDisplayValue(result, const_cast<PatternBitfield*>(this));
         }
 
         std::string formatDisplayValue() override {
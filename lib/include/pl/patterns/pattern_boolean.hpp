@@ -14,10 +14,11 @@ namespace pl::ptrn {
         }
 
         [[nodiscard]] core::Token::Literal getValue() const override {
-            bool boolean = false;
-            this->getEvaluator()->readData(this->getOffset(), &boolean, 1, this->getSection());
+            return this->getValueAt(this->getOffset());
+        }
 
-            return transformValue(boolean);
+        [[nodiscard]] core::Token::Literal getValueAt(u64 offset) const {
+            return transformValue(this->readByte(offset) != 0x00);
         }
 
         std::vector<u8> getBytesOf(const core::Token::Literal &value) const override {
@@ -32,7 +33,14 @@ namespace pl::ptrn {
         }
 
         std::string formatDisplayValue() override {
-            switch (this->getValue().toUnsigned()) {
+            return this->formatDisplayValueAt(this->getOffset());
+        }
+
+        std::string formatDisplayValueAt(u64 offset) override {
+            // Bytes other than 0 and 1 are true as well but get marked as unusual
+            const auto value = this->getTransformFunction().empty() ? u128(this->readByte(offset)) : this->getValueAt(offset).toUnsigned();
+
+            switch (value) {
                 case 0: return "false";
                 case 1: return "true";
                 default: return "true*";
@@ -51,6 +59,15 @@ namespace pl::ptrn {
 
             return Pattern::formatDisplayValue(result, value);
         }
+
+    private:
+        [[nodiscard]] u8 readByte(u64 offset) const {
+            // Read a whole byte since any value other than 0 and 1 stored in a bool is undefined behaviour
+            u8 byte = 0x00;
+            this->getEvaluator()->readData(offset, &byte, 1, this->getSection());
+
+            return byte;
+        }
     };
 
 }
\ No newline at end of file
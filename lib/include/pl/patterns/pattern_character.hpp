@@ -14,8 +14,12 @@ namespace pl::ptrn {
         }
 
         [[nodiscard]] core::Token::Literal getValue() const override {
+            return this->getValueAt(this->getOffset());
+        }
+
+        [[nodiscard]] core::Token::Literal getValueAt(u64 offset) const {
             char character = '\x00';
-            this->getEvaluator()->readData(this->getOffset(), &character, 1, this->getSection());
+            this->getEvaluator()->readData(offset, &character, 1, this->getSection());
 
             return transformValue(character);
         }
@@ -32,8 +36,13 @@ namespace pl::ptrn {
         }
 
         std::string formatDisplayValue() override {
-            const u8 character = this->getValue().toCharacter();
-            return Pattern::formatDisplayValue(fmt::format("'{0}'", hlp::encodeByteString({ character })), this->getValue());
+            return this->formatDisplayValueAt(this->getOffset());
+        }
+
+        std::string formatDisplayValueAt(u64 offset) override {
+            const auto value = this->getValueAt(offset);
+            const u8 character = value.toCharacter();
+            return Pattern::formatDisplayValue(fmt::format("'{0}'", hlp::encodeByteString({ character })), value);
         }
 
         [[nodiscard]] bool operator==(const Pattern &other) const override { return compareCommonProperties<decltype(*this)>(other); }
@@ -88,7 +88,7 @@ namespace pl::ptrn {
             if (!foundValue)
                 result += "???";
 
-            return Pattern::formatDisplayValue(result, this->clone().get());
+            return Pattern::formatDisplayValue(result, const_cast<PatternEnum*>(this));
         }
 
     private:
@@ -14,9 +14,13 @@ namespace pl::ptrn {
         }
 
         [[nodiscard]] core::Token::Literal getValue() const override {
+            return this->getValueAt(this->getOffset());
+        }
+
+        [[nodiscard]] core::Token::Literal getValueAt(u64 offset) const {
             if (this->getSize() == 4) {
                 u32 data = 0;
-                this->getEvaluator()->readData(this->getOffset(), &data, 4, this->getSection());
+                this->getEvaluator()->readData(offset, &data, 4, this->getSection());
                 data = hlp::changeEndianess(data, 4, this->getEndian());
 
                 float result = 0;
@@ -24,7 +28,7 @@ namespace pl::ptrn {
                 return transformValue(double(result));
             } else if (this->getSize() == 8) {
                 u64 data = 0;
-                this->getEvaluator()->readData(this->getOffset(), &data, 8, this->getSection());
+                this->getEvaluator()->readData(offset, &data, 8, this->getSection());
                 data = hlp::changeEndianess(data, 8, this->getEndian());
 
                 double result = 0;
@@ -65,7 +69,11 @@ namespace pl::ptrn {
         }
 
         std::string formatDisplayValue() override {
-            auto value = this->getValue().toFloatingPoint();
+            return this->formatDisplayValueAt(this->getOffset());
+        }
+
+        std::string formatDisplayValueAt(u64 offset) override {
+            auto value = this->getValueAt(offset).toFloatingPoint();
             if (this->getSize() == 4) {
                 auto f32 = static_cast<float>(value);
                 u32 integerResult = 0;
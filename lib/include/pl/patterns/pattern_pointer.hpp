@@ -49,6 +49,19 @@ namespace pl::ptrn {
             return children;
         }
 
+        [[nodiscard]] std::vector<std::pair<u64, Pattern*>> getIndexChildren() override {
+            auto children = this->m_pointedAt->getIndexChildren();
+            children.emplace_back(this->getOffset(), this);
+            return children;
+        }
+
+        void forEachChildAt(u64 offset, const std::function<void(u64, const Pattern*)> &callback) const override {
+            wolv::util::unused(offset);
+
+            // The pointed at pattern doesn't move with the pointer
+            callback(this->m_pointedAt->getOffset(), this->m_pointedAt.get());
+        }
+
         void setSection(u64 id) override {
             this->m_pointedAt->setSection(id);
 
@@ -69,7 +82,7 @@ namespace pl::ptrn {
 
         void setPointedAtPattern(std::shared_ptr<Pattern> &&pattern) {
             this->m_pointedAt = std::move(pattern);
-            this->m_pointedAt->setVariableName(fmt::format("*({})", this->getVariableName()));
+            this->m_pointedAt->setDereferencedName(*this);
             this->m_pointedAt->setOffset(this->m_pointedAtAddress);
 
             if (this->hasOverriddenColor())
@@ -149,7 +162,7 @@ namespace pl::ptrn {
         [[nodiscard]] std::string toString() const override {
             auto result = this->m_pointedAt->toString();
 
-            return Pattern::formatDisplayValue(result, this->clone().get());
+            return Pattern::formatDisplayValue(result, const_cast<PatternPointer*>(this));
         }
 
     private:
@@ -14,8 +14,12 @@ namespace pl::ptrn {
         }
 
         [[nodiscard]] core::Token::Literal getValue() const override {
+            return this->getValueAt(this->getOffset());
+        }
+
+        [[nodiscard]] core::Token::Literal getValueAt(u64 offset) const {
             i128 data = 0;
-            this->getEvaluator()->readData(this->getOffset(), &data, this->getSize(), this->getSection());
+            this->getEvaluator()->readData(offset, &data, this->getSize(), this->getSection());
             data = hlp::changeEndianess(data, this->getSize(), this->getEndian());
 
             return transformValue(hlp::signExtend(this->getSize() * 8, data));
@@ -32,10 +36,15 @@ namespace pl::ptrn {
         }
 
         std::string formatDisplayValue() override {
-            auto data = this->getValue().toSigned();
+            return this->formatDisplayValueAt(this->getOffset());
+        }
+
+        std::string formatDisplayValueAt(u64 offset) override {
+            auto value = this->getValueAt(offset);
+            auto data = value.toSigned();
             auto size = this->getSize();
 
-            return Pattern::formatDisplayValue(fmt::format("{:d} (0x{:0{}X})", data, u128(data) & hlp::bitmask(8 * size), size * 2), this->getValue());
+            return Pattern::formatDisplayValue(fmt::format("{:d} (0x{:0{}X})", data, u128(data) & hlp::bitmask(8 * size), size * 2), value);
         }
 
         [[nodiscard]] std::string toString() const override {
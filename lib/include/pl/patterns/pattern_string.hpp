@@ -69,7 +69,7 @@ namespace pl::ptrn {
         }
 
         std::shared_ptr<Pattern> getEntry(size_t index) const override {
-            auto result = std::make_shared<PatternCharacter>(this->getEvaluator(), this->getOffset() + index);
+            auto result = hlp::makeShared<PatternCharacter>(this->getEvaluator(), this->getOffset() + index);
             result->setSection(this->getSection());
 
             return result;
@@ -11,51 +11,45 @@ namespace pl::ptrn {
         PatternStruct(core::Evaluator *evaluator, u64 offset, size_t size)
             : Pattern(evaluator, offset, size) { }
 
-        PatternStruct(const PatternStruct &other) : Pattern(other) {
-            for (const auto &member : other.m_members) {
-                auto copy = member->clone();
-
-                this->m_sortedMembers.push_back(copy.get());
-                this->m_members.push_back(std::move(copy));
-            }
-        }
+        PatternStruct(const PatternStruct &other) : Pattern(other), m_members(other.m_members) { }
 
         [[nodiscard]] std::unique_ptr<Pattern> clone() const override {
             return std::unique_ptr<Pattern>(new PatternStruct(*this));
         }
 
         [[nodiscard]] std::shared_ptr<Pattern> getEntry(size_t index) const override {
-            return this->m_members[index];
+            return this->m_members.members[index];
         }
 
         [[nodiscard]] std::vector<std::shared_ptr<Pattern>> getEntries() override {
-            return this->m_members;
+            return this->m_members.members;
         }
 
         void forEachEntry(u64 start, u64 end, const std::function<void(u64, Pattern*)>& fn) override {
             if (this->isSealed())
                 return;
 
-            for (u64 i = start; i < this->m_sortedMembers.size() && i < end; i++) {
-                auto pattern = this->m_sortedMembers[i];
+            const auto &sortedMembers = this->m_members.sortedMembers;
+            for (u64 i = start; i < sortedMembers.size() && i < end; i++) {
+                auto pattern = sortedMembers[i];
                 if (!pattern->isPatternLocal())
                     fn(i, pattern);
             }
         }
 
         size_t getEntryCount() const override {
-            return this->m_members.size();
+            return this->m_members.members.size();
         }
 
         void setOffset(u64 offset) override {
-            for (auto &member : this->m_members)
+            for (auto &member : this->m_members.members)
                 member->setOffset(member->getOffset() - this->getOffset() + offset);
 
             Pattern::setOffset(offset);
         }
 
         void setSection(u64 id) override {
-            for (auto &member : this->m_members)
+            for (auto &member : this->m_members.members)
                 if (member->getSection() == ptrn::Pattern::MainSectionId)
                     member->setSection(id);
 
@@ -68,7 +62,7 @@ namespace pl::ptrn {
             else {
                 std::vector<std::pair<u64, Pattern*>> result;
 
-                for (const auto &member : this->m_members) {
+                for (const auto &member : this->m_members.members) {
                     auto children = member->getChildren();
                     std::copy(children.begin(), children.end(), std::back_inserter(result));
                 }
@@ -77,15 +71,40 @@ namespace pl::ptrn {
             }
         }
 
+        [[nodiscard]] std::vector<std::pair<u64, Pattern*>> getIndexChildren() override {
+            if (this->isSealed())
+                return { { this->getOffset(), this } };
+            else {
+                std::vector<std::pair<u64, Pattern*>> result;
+
+                for (const auto &member : this->m_members.members) {
+                    auto children = member->getIndexChildren();
+                    std::copy(children.begin(), children.end(), std::back_inserter(result));
+                }
+
+                return result;
+            }
+        }
+
+        void forEachChildAt(u64 offset, const std::function<void(u64, const Pattern*)> &callback) const override {
+            if (this->isSealed())
+                return;
+
+            for (const auto member : this->m_members.sortedMembers) {
+                if (!member->isPatternLocal())
+                    callback(member->getOffset() - this->getOffset() + offset, member);
+            }
+        }
+
         void setLocal(bool local) override {
-            for (auto &pattern : this->m_members)
+            for (auto &pattern : this->m_members.members)
                 pattern->setLocal(local);
 
             Pattern::setLocal(local);
         }
 
         void setReference(bool reference) override {
-            for (auto &pattern : this->m_members)
+            for (auto &pattern : this->m_members.members)
                 pattern->setReference(reference);
 
             Pattern::setReference(reference);
@@ -93,12 +112,18 @@ namespace pl::ptrn {
 
         void setColor(u32 color) override {
             Pattern::setColor(color);
-            for (auto &member : this->m_members) {
+            for (auto &member : this->m_members.members) {
                 if (!member->hasOverriddenColor())
                     member->setColor(color);
             }
         }
 
+        void clearFormatCache() override {
+            Pattern::clearFormatCache();
+            for (const auto &member : this->m_members.members)
+                member->clearFormatCache();
+        }
+
         [[nodiscard]] std::string getFormattedName() const override {
             return "struct " + Pattern::getTypeName();
         }
@@ -107,14 +132,15 @@ namespace pl::ptrn {
             std::string result = this->getFormattedName();
             result += " { ";
 
-            for (const auto &member : this->m_members) {
+            const auto &members = this->m_members.members;
+            for (const auto &member : members) {
                 if (member->getVariableName().starts_with("$"))
                     continue;
 
                 result += fmt::format("{} = {}, ", member->getVariableName(), member->toString());
             }
 
-            if (!this->m_members.empty()) {
+            if (!members.empty()) {
                 // Remove trailing ", "
                 result.pop_back();
                 result.pop_back();
@@ -122,31 +148,34 @@ namespace pl::ptrn {
 
             result += " }";
 
-            return Pattern::formatDisplayValue(result, this->clone().get());
+            return Pattern::formatDisplayValue(result, const_cast<PatternStruct*>(this));
         }
 
         void setMembers(std::vector<std::shared_ptr<Pattern>> members) {
-            this->m_members.clear();
+            this->m_members = { };
 
+            auto &[ownMembers, sortedMembers] = this->m_members;
             for (auto &member : members) {
                 if (member == nullptr) continue;
 
-                this->m_sortedMembers.push_back(member.get());
-                this->m_members.push_back(std::move(member));
+                sortedMembers.push_back(member.get());
+                ownMembers.push_back(std::move(member));
             }
 
-            if (!this->m_members.empty())
-                this->setBaseColor(this->m_members.front()->getColor());
+            if (!ownMembers.empty())
+                this->setBaseColor(ownMembers.front()->getColor());
         }
 
         void sort(const std::function<bool (const Pattern *, const Pattern *)> &comparator) override {
-            this->m_sortedMembers.clear();
-            for (auto &member : this->m_members)
-                this->m_sortedMembers.push_back(member.get());
+            auto &[members, sortedMembers] = this->m_members;
 
-            std::sort(this->m_sortedMembers.begin(), this->m_sortedMembers.end(), comparator);
+            sortedMembers.clear();
+            for (auto &member : members)
+                sortedMembers.push_back(member.get());
 
-            for (auto &member : this->m_members)
+            std::sort(sortedMembers.begin(), sortedMembers.end(), comparator);
+
+            for (auto &member : members)
                 member->sort(comparator);
         }
 
@@ -155,11 +184,13 @@ namespace pl::ptrn {
                 return false;
 
             auto &otherStruct = *static_cast<const PatternStruct *>(&other);
-            if (this->m_members.size() != otherStruct.m_members.size())
+            const auto &members = this->m_members.members;
+            const auto &otherMembers = otherStruct.m_members.members;
+            if (members.size() != otherMembers.size())
                 return false;
 
-            for (u64 i = 0; i < this->m_members.size(); i++) {
-                if (*this->m_members[i] != *otherStruct.m_members[i])
+            for (u64 i = 0; i < members.size(); i++) {
+                if (*members[i] != *otherMembers[i])
                     return false;
             }
 
@@ -171,7 +202,7 @@ namespace pl::ptrn {
 
             Pattern::setEndian(endian);
 
-            for (auto &member : this->m_members) {
+            for (auto &member : this->m_members.members) {
                 if (!member->hasOverriddenEndian())
                     member->setEndian(endian);
             }
@@ -186,8 +217,31 @@ namespace pl::ptrn {
         }
 
     private:
-        std::vector<std::shared_ptr<Pattern>> m_members;
-        std::vector<Pattern *> m_sortedMembers;
+        struct Members {
+            Members() = default;
+            Members(const Members &other) {
+                std::unordered_map<const Pattern*, Pattern*> copies;
+                for (const auto &member : other.members) {
+                    auto copy = member->clone();
+
+                    copies[member.get()] = copy.get();
+                    this->members.push_back(std::move(copy));
+                }
+
+                for (const auto &member : other.sortedMembers)
+                    this->sortedMembers.push_back(copies[member]);
+            }
+            Members(Members&&) = default;
+
+            Members &operator=(const Members&) = delete;
+            Members &operator=(Members&&) = default;
+
+            std::vector<std::shared_ptr<Pattern>> members;
+            std::vector<Pattern *> sortedMembers;
+        };
+
+        // Clones own copies of all members, so pointers to the members of one stay valid whatever happens to the other
+        Members m_members;
     };
 
 }
\ No newline at end of file
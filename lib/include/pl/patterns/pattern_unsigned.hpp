@@ -14,8 +14,12 @@ namespace pl::ptrn {
         }
 
         [[nodiscard]] core::Token::Literal getValue() const override {
+            return this->getValueAt(this->getOffset());
+        }
+
+        [[nodiscard]] core::Token::Literal getValueAt(u64 offset) const {
             u128 data = 0;
-            this->getEvaluator()->readData(this->getOffset(), &data, this->getSize(), this->getSection());
+            this->getEvaluator()->readData(offset, &data, this->getSize(), this->getSection());
             return transformValue(hlp::changeEndianess(data, this->getSize(), this->getEndian()));
         }
 
@@ -30,8 +34,13 @@ namespace pl::ptrn {
         }
 
         std::string formatDisplayValue() override {
-            auto data = this->getValue().toUnsigned();
-            return Pattern::formatDisplayValue(fmt::format("{:d} (0x{:0{}X})", data, data, this->getSize() * 2), this->getValue());
+            return this->formatDisplayValueAt(this->getOffset());
+        }
+
+        std::string formatDisplayValueAt(u64 offset) override {
+            auto value = this->getValueAt(offset);
+            auto data = value.toUnsigned();
+            return Pattern::formatDisplayValue(fmt::format("{:d} (0x{:0{}X})", data, data, this->getSize() * 2), value);
         }
 
         [[nodiscard]] std::string toString() const override {
@@ -17,8 +17,12 @@ namespace pl::ptrn {
         }
 
         [[nodiscard]] core::Token::Literal getValue() const override {
+            return this->getValueAt(this->getOffset());
+        }
+
+        [[nodiscard]] core::Token::Literal getValueAt(u64 offset) const {
             char16_t character = '\u0000';
-            this->getEvaluator()->readData(this->getOffset(), &character, 2, this->getSection());
+            this->getEvaluator()->readData(offset, &character, 2, this->getSection());
             return transformValue(u128(hlp::changeEndianess(character, this->getEndian())));
         }
 
@@ -27,13 +31,7 @@ namespace pl::ptrn {
         }
 
         [[nodiscard]] std::string toString() const override {
-            auto value = this->getValue();
-            char16_t character = value.toUnsigned();
-            character = hlp::changeEndianess(character, this->getEndian());
-
-            auto result = std::wstring_convert<std::codecvt_utf8_utf16<char16_t>, char16_t>("???").to_bytes(character);
-
-            return Pattern::formatDisplayValue(result, value);
+            return this->formatCharacter(this->getValue());
         }
 
         [[nodiscard]] bool operator==(const Pattern &other) const override { return compareCommonProperties<decltype(*this)>(other); }
@@ -43,7 +41,22 @@ namespace pl::ptrn {
         }
 
         std::string formatDisplayValue() override {
-            return Pattern::formatDisplayValue(fmt::format("'{0}'", this->toString()), this->getValue());
+            return this->formatDisplayValueAt(this->getOffset());
+        }
+
+        std::string formatDisplayValueAt(u64 offset) override {
+            const auto value = this->getValueAt(offset);
+            return Pattern::formatDisplayValue(fmt::format("'{0}'", this->formatCharacter(value)), value);
+        }
+
+    private:
+        [[nodiscard]] std::string formatCharacter(const core::Token::Literal &value) const {
+            char16_t character = value.toUnsigned();
+            character = hlp::changeEndianess(character, this->getEndian());
+
+            auto result = std::wstring_convert<std::codecvt_utf8_utf16<char16_t>, char16_t>("???").to_bytes(character);
+
+            return Pattern::formatDisplayValue(result, value);
         }
     };
 
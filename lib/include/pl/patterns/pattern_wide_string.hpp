@@ -76,7 +76,7 @@ namespace pl::ptrn {
         }
 
         std::shared_ptr<Pattern> getEntry(size_t index) const override {
-            auto result = std::make_shared<PatternWideCharacter>(this->getEvaluator(), this->getOffset() + index * sizeof(char16_t));
+            auto result = hlp::makeShared<PatternWideCharacter>(this->getEvaluator(), this->getOffset() + index * sizeof(char16_t));
             result->setSection(this->getSection());
 
             return result;
@@ -19,8 +19,30 @@
 #include <pl/patterns/pattern_wide_character.hpp>
 #include <pl/patterns/pattern_string.hpp>
 
+#include <algorithm>
+
 namespace pl::core {
 
+    thread_local std::vector<std::pair<u64, u64>> Evaluator::s_currArrayIndices;
+    std::atomic<u64> Evaluator::s_nextEvaluatorId = 0;
+
+    Evaluator::~Evaluator() {
+        this->releasePatterns();
+    }
+
+    void Evaluator::releasePatterns() {
+        this->m_scopes.clear();
+        this->m_templateParameters.clear();
+        this->m_patterns.clear();
+        this->m_appendCheckpoint.reset();
+
+        // Patterns that are still referenced keep the arena alive until they're destroyed. Otherwise all its slabs are freed at once
+        if (this->m_patternArena != nullptr) {
+            this->m_patternArena->release();
+            this->m_patternArena = nullptr;
+        }
+    }
+
     std::map<std::string, Token::Literal> Evaluator::getOutVariables() const {
         std::map<std::string, Token::Literal> result;
 
@@ -141,17 +163,17 @@ namespace pl::core {
                 err::E0003.throwError("Cannot determine type of 'auto' variable.", "Try initializing it directly with a literal.", type);
 
             if (std::get_if<u128>(&value.value()) != nullptr)
-                pattern = std::make_shared<ptrn::PatternUnsigned>(this, 0, sizeof(u128));
+                pattern = hlp::makeShared<ptrn::PatternUnsigned>(this, 0, sizeof(u128));
             else if (std::get_if<i128>(&value.value()) != nullptr)
-                pattern = std::make_shared<ptrn::PatternSigned>(this, 0, sizeof(i128));
+                pattern = hlp::makeShared<ptrn::PatternSigned>(this, 0, sizeof(i128));
             else if (std::get_if<double>(&value.value()) != nullptr)
-                pattern = std::make_shared<ptrn::PatternFloat>(this, 0, sizeof(double));
+                pattern = hlp::makeShared<ptrn::PatternFloat>(this, 0, sizeof(double));
             else if (std::get_if<bool>(&value.value()) != nullptr)
-                pattern = std::make_shared<ptrn::PatternBoolean>(this, 0);
+                pattern = hlp::makeShared<ptrn::PatternBoolean>(this, 0);
             else if (std::get_if<char>(&value.value()) != nullptr)
-                pattern = std::make_shared<ptrn::PatternCharacter>(this, 0);
+                pattern = hlp::makeShared<ptrn::PatternCharacter>(this, 0);
             else if (auto string = std::get_if<std::string>(&value.value()); string != nullptr)
-                pattern = std::make_shared<ptrn::PatternString>(this, 0, string->size());
+                pattern = hlp::makeShared<ptrn::PatternString>(this, 0, string->size());
             else if (auto patternValue = std::get_if<ptrn::Pattern *>(&value.value()); patternValue != nullptr)
                 pattern       = (*patternValue)->clone();
             else
@@ -510,13 +532,21 @@ namespace pl::core {
                 err::E0011.throwError(fmt::format("Tried accessing out of bounds pattern local storage cell {}. This is a bug.", heapAddress));
         } else if (sectionId == ptrn::Pattern::MainSectionId) {
             if (!write) {
-                if (address < this->m_dataBaseAddress + this->m_dataSize)
+                if (!this->m_evaluated)
+                    this->addLayoutRead(address, size);
+
+                if (address < this->m_dataBaseAddress + this->m_dataSize) {
+                    // Formatters read from multiple threads at once, data sources such as files only handle one access at a time
+                    std::scoped_lock lock(this->m_dataSourceMutex);
                     this->m_readerFunction(address, reinterpret_cast<u8*>(buffer), size);
-                else
+                } else {
                     std::memset(buffer, 0x00, size);
+                }
             } else {
-                if (address < this->m_dataBaseAddress + this->m_dataSize)
+                if (address < this->m_dataBaseAddress + this->m_dataSize) {
+                    std::scoped_lock lock(this->m_dataSourceMutex);
                     this->m_writerFunction(address, reinterpret_cast<u8*>(buffer), size);
+                }
             }
         } else {
             if (this->m_sections.contains(sectionId)) {
@@ -597,9 +627,12 @@ namespace pl::core {
         this->m_templateParameters.clear();
 
         this->m_customFunctions.clear();
-        this->m_patterns.clear();
+        this->releasePatterns();
 
         this->m_mainResult.reset();
+        this->m_topLevelArrayNode = nullptr;
+        this->m_appendCheckpoint.reset();
+        this->m_layoutReads.clear();
         this->m_colorIndex = 0;
         this->m_aborted = false;
         this->m_evaluated = false;
@@ -610,16 +643,20 @@ namespace pl::core {
         ON_SCOPE_EXIT {
             this->m_envVariables.clear();
             this->m_evaluated = true;
+            this->mergeLayoutReads();
         };
 
         this->m_currPatternCount = 0;
 
         this->m_customFunctionDefinitions.clear();
 
+        this->m_patternArena = hlp::Arena::create();
+        hlp::Arena::Scope arenaScope(this->m_patternArena);
+
         if (this->isDebugModeEnabled())
             this->m_console.log(LogConsole::Level::Debug, fmt::format("Base Pattern size: 0x{:02X} bytes", sizeof(ptrn::Pattern)));
 
-        try {
+        return this->runEvaluation(sourceCode, [&] {
             this->setCurrentControlFlowStatement(ControlFlowStatement::None);
             this->pushScope(nullptr, this->m_patterns);
             this->pushTemplateParameters();
@@ -637,6 +674,10 @@ namespace pl::core {
 
                     auto startOffset = this->dataOffset();
 
+                    // Evaluation can only be resumed from arrays that aren't followed by anything that depends on their end
+                    if (dynamic_cast<ast::ASTNodeTypeDecl *>(node) == nullptr && dynamic_cast<ast::ASTNodeFunctionDefinition *>(node) == nullptr)
+                        this->m_appendCheckpoint.reset();
+
                     if (dynamic_cast<ast::ASTNodeTypeDecl *>(node) != nullptr) {
                         // Don't create patterns from type declarations
                     } else if (dynamic_cast<ast::ASTNodeFunctionDefinition *>(node) != nullptr) {
@@ -656,7 +697,7 @@ namespace pl::core {
                                     this->setVariable(name, this->m_inVariables[name]);
 
                                 this->dataOffset() = startOffset;
-                            } else {
+                            } else if (this->sinkPattern(pattern)) {
                                 this->m_patterns.push_back(std::move(pattern));
                             }
 
@@ -672,12 +713,19 @@ namespace pl::core {
                         if (localVariable)
                             this->pushSectionId(ptrn::Pattern::HeapSectionId);
 
-                        for (auto &pattern : arrayVarDeclNode->createPatterns(this)) {
+                        this->m_topLevelArrayNode = localVariable ? nullptr : arrayVarDeclNode;
+                        auto patterns = arrayVarDeclNode->createPatterns(this);
+                        this->m_topLevelArrayNode = nullptr;
+
+                        if (this->m_appendCheckpoint.has_value() && patterns.size() == 1)
+                            this->m_appendCheckpoint->arrayPattern = patterns.front();
+
+                        for (auto &pattern : patterns) {
                             if (localVariable) {
                                 wolv::util::unused(arrayVarDeclNode->execute(this));
 
                                 this->dataOffset() = startOffset;
-                            } else {
+                            } else if (this->sinkPattern(pattern)) {
                                 this->m_patterns.push_back(std::move(pattern));
                             }
                         }
@@ -688,7 +736,7 @@ namespace pl::core {
                         for (auto &pattern : pointerVarDecl->createPatterns(this)) {
                             if (pointerVarDecl->getPlacementOffset() == nullptr) {
                                 err::E0003.throwError("Pointers cannot be used as local variables.");
-                            } else {
+                            } else if (this->sinkPattern(pattern)) {
                                 this->m_patterns.push_back(std::move(pattern));
                             }
                         }
@@ -699,15 +747,122 @@ namespace pl::core {
                     }
 
                     if (this->getCurrentControlFlowStatement() == ControlFlowStatement::Return)
-                        goto stop_evaluation;
+                        return;
                     else
                         this->setCurrentControlFlowStatement(ControlFlowStatement::None);
                 }
 
                 this->getScope(0).savedPatterns.clear();
             }
+        });
+    }
+
+    bool Evaluator::canResumeEvaluation() const {
+        if (!this->m_appendCheckpoint.has_value() || this->m_appendCheckpoint->arrayPattern == nullptr)
+            return false;
+
+        const auto &checkpoint = *this->m_appendCheckpoint;
+        return checkpoint.dataBaseAddress == this->m_dataBaseAddress && checkpoint.dataSize <= this->m_dataSize;
+    }
+
+    bool Evaluator::resumeEvaluation(const std::string &sourceCode) {
+        if (!this->canResumeEvaluation())
+            return false;
+
+        auto checkpoint = std::move(*this->m_appendCheckpoint);
+        this->m_appendCheckpoint.reset();
 
-            stop_evaluation:
+        // Undo what the main function did at the end of the last evaluation. It runs again once the new entries were added
+        this->m_sections  = std::move(checkpoint.sections);
+        this->m_sectionId = checkpoint.sectionId;
+        this->m_heap      = std::move(checkpoint.heap);
+        this->getConsole().setLog(std::move(checkpoint.consoleLog));
+
+        this->m_mainResult.reset();
+        this->m_aborted = false;
+        this->m_evaluated = false;
+
+        ON_SCOPE_EXIT {
+            this->m_envVariables.clear();
+            this->m_evaluated = true;
+            this->mergeLayoutReads();
+        };
+
+        hlp::Arena::Scope arenaScope(this->m_patternArena);
+
+        return this->runEvaluation(sourceCode, [&] {
+            this->setCurrentControlFlowStatement(ControlFlowStatement::None);
+            this->dataOffset() = checkpoint.offset;
+
+            auto arrayPattern = static_cast<ptrn::PatternArrayDynamic*>(checkpoint.arrayPattern.get());
+
+            this->m_topLevelArrayNode = checkpoint.arrayNode;
+            checkpoint.arrayNode->resumeDynamicArray(this, arrayPattern, checkpoint.entryIndex);
+            this->m_topLevelArrayNode = nullptr;
+
+            if (this->m_appendCheckpoint.has_value())
+                this->m_appendCheckpoint->arrayPattern = checkpoint.arrayPattern;
+
+            // Arrays released by the pattern sink are handed to it again together with their new entries
+            if (std::ranges::find(this->m_patterns, checkpoint.arrayPattern) == this->m_patterns.end() && this->sinkPattern(checkpoint.arrayPattern))
+                this->m_patterns.push_back(checkpoint.arrayPattern);
+        });
+    }
+
+    bool Evaluator::isLayoutDependentOn(u64 address, size_t size) const {
+        if (size == 0)
+            return false;
+
+        // Ranges are sorted and don't overlap once evaluation finished, so only the last range starting before the end can overlap
+        const auto end = address + size;
+        auto it = std::ranges::upper_bound(this->m_layoutReads, end - 1, {}, &LayoutRead::start);
+        if (it == this->m_layoutReads.begin())
+            return false;
+
+        return std::prev(it)->end > address;
+    }
+
+    void Evaluator::addLayoutRead(u64 address, size_t size) {
+        if (size == 0)
+            return;
+
+        // Most reads continue where the previous one ended so they're merged right away
+        if (!this->m_layoutReads.empty()) {
+            auto &last = this->m_layoutReads.back();
+            if (address >= last.start && address <= last.end) {
+                last.end = std::max<u64>(last.end, address + size);
+                return;
+            }
+        }
+
+        this->m_layoutReads.push_back({ address, address + size });
+    }
+
+    void Evaluator::mergeLayoutReads() {
+        std::ranges::sort(this->m_layoutReads, {}, &LayoutRead::start);
+
+        std::vector<LayoutRead> merged;
+        for (const auto &read : this->m_layoutReads) {
+            if (!merged.empty() && read.start <= merged.back().end)
+                merged.back().end = std::max(merged.back().end, read.end);
+            else
+                merged.push_back(read);
+        }
+
+        this->m_layoutReads = std::move(merged);
+    }
+
+    bool Evaluator::runEvaluation(const std::string &sourceCode, const std::function<void()> &function) {
+        try {
+            function();
+
+            if (this->m_appendCheckpoint.has_value()) {
+                auto &checkpoint = *this->m_appendCheckpoint;
+                checkpoint.sections   = this->m_sections;
+                checkpoint.sectionId  = this->m_sectionId;
+                checkpoint.heap       = this->m_heap;
+                checkpoint.consoleLog = this->getConsole().getLog();
+            }
 
             if (!this->m_mainResult.has_value() && this->m_customFunctions.contains("main")) {
                 auto mainFunction = this->m_customFunctions["main"];
@@ -717,6 +872,9 @@ namespace pl::core {
 
                 this->m_mainResult = mainFunction.func(this, {});
             }
+
+            if (this->m_appendCheckpoint.has_value() && this->m_appendCheckpoint->droppedEntry)
+                this->getConsole().log(LogConsole::Level::Info, fmt::format("The entry at 0x{:X} doesn't fit into the data yet. It gets added once more data is available.", this->m_appendCheckpoint->offset));
         } catch (err::EvaluatorError::Exception &e) {
 
             auto node = e.getUserData();
@@ -731,6 +889,7 @@ namespace pl::core {
                 return false;
 
             this->m_patterns.clear();
+            this->m_appendCheckpoint.reset();
 
             this->m_currPatternCount = 0;
 
@@ -775,6 +934,8 @@ namespace pl::core {
         this->m_currPatternCount++;
 
         if (pattern->isPatternLocal()) {
+            std::scoped_lock lock(this->m_patternLocalStorageMutex);
+
             if (auto it = this->m_patternLocalStorage.find(pattern->getHeapAddress()); it != this->m_patternLocalStorage.end()) {
                 auto &[key, data] = *it;
 
@@ -787,6 +948,8 @@ namespace pl::core {
         this->m_currPatternCount--;
 
         if (pattern->isPatternLocal()) {
+            std::scoped_lock lock(this->m_patternLocalStorageMutex);
+
             if (auto it = this->m_patternLocalStorage.find(pattern->getHeapAddress()); it != this->m_patternLocalStorage.end()) {
                 auto &[key, data] = *it;
 
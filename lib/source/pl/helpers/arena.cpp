@@ -0,0 +1,181 @@
+#include <pl/helpers/arena.hpp>
+
+#include <algorithm>
+#include <new>
+
+namespace pl::hlp {
+
+    namespace {
+
+        thread_local Arena *s_currentArena = nullptr;
+
+        constexpr size_t getSizeClass(size_t size) {
+            return (size + Arena::Granularity - 1) / Arena::Granularity - 1;
+        }
+
+        constexpr size_t getObjectSize(size_t sizeClass) {
+            return (sizeClass + 1) * Arena::Granularity;
+        }
+
+        constexpr size_t getSlabHeaderSize() {
+            return (sizeof(void*) + Arena::Granularity - 1) / Arena::Granularity * Arena::Granularity;
+        }
+
+    }
+
+    Arena* Arena::create() {
+        return new Arena();
+    }
+
+    // Objects allocated while no arena is current end up here. It's never destroyed but gives its slabs back whenever it runs empty
+    Arena* Arena::getDefaultArena() {
+        static Arena *arena = Arena::create();
+
+        return arena;
+    }
+
+    Arena::~Arena() {
+        for (auto slab : this->m_slabs)
+            ::operator delete(slab, std::align_val_t(SlabSize));
+    }
+
+    void Arena::release() {
+        bool destroy;
+        {
+            std::scoped_lock lock(this->m_mutex);
+
+            this->m_released = true;
+            destroy = this->m_allocationCount == 0;
+        }
+
+        if (destroy)
+            delete this;
+    }
+
+    size_t Arena::getAllocationCount() const {
+        std::scoped_lock lock(this->m_mutex);
+
+        return this->m_allocationCount;
+    }
+
+    void* Arena::allocate(size_t size) {
+        if (size == 0 || size > MaxAllocationSize)
+            return ::operator new(size);
+
+        auto arena = s_currentArena == nullptr ? getDefaultArena() : s_currentArena;
+
+        return arena->allocateFromSlab(getSizeClass(size));
+    }
+
+    void Arena::deallocate(void *pointer, size_t size) {
+        if (pointer == nullptr)
+            return;
+
+        if (size == 0 || size > MaxAllocationSize) {
+            ::operator delete(pointer);
+            return;
+        }
+
+        // Slabs are aligned to their size so the owning arena can be found from the slab header
+        auto slab = reinterpret_cast<Slab*>(reinterpret_cast<uintptr_t>(pointer) & ~uintptr_t(SlabSize - 1));
+
+        slab->arena->deallocateToSlab(pointer, getSizeClass(size));
+    }
+
+    void* Arena::allocateFromSlab(size_t sizeClass) {
+        std::scoped_lock lock(this->m_mutex);
+
+        this->m_allocationCount += 1;
+
+        auto &freeList = this->m_freeLists[sizeClass];
+        if (freeList != nullptr) {
+            auto node = freeList;
+            freeList = node->next;
+
+            return node;
+        }
+
+        const auto objectSize = getObjectSize(sizeClass);
+        if (size_t(this->m_bumpEnd - this->m_bumpPointer) < objectSize)
+            this->addSlab();
+
+        auto result = this->m_bumpPointer;
+        this->m_bumpPointer += objectSize;
+
+        return result;
+    }
+
+    void Arena::deallocateToSlab(void *pointer, size_t sizeClass) {
+        bool destroy;
+        {
+            std::scoped_lock lock(this->m_mutex);
+
+            this->addToFreeList(pointer, sizeClass);
+            this->m_allocationCount -= 1;
+
+            if (this == getDefaultArena() && this->m_allocationCount == 0)
+                this->trim();
+
+            destroy = this->m_released && this->m_allocationCount == 0;
+        }
+
+        if (destroy)
+            delete this;
+    }
+
+    void Arena::addToFreeList(void *pointer, size_t sizeClass) {
+        auto node = static_cast<FreeNode*>(pointer);
+
+        node->next = this->m_freeLists[sizeClass];
+        this->m_freeLists[sizeClass] = node;
+    }
+
+    void Arena::addSlab() {
+        this->recycle(this->m_bumpPointer, this->m_bumpEnd);
+
+        auto slab = static_cast<Slab*>(::operator new(SlabSize, std::align_val_t(SlabSize)));
+        slab->arena = this;
+        this->m_slabs.push_back(slab);
+
+        this->m_bumpPointer = reinterpret_cast<u8*>(slab) + getSlabHeaderSize();
+        this->m_bumpEnd = reinterpret_cast<u8*>(slab) + SlabSize;
+    }
+
+    void Arena::recycle(u8 *begin, u8 *end) {
+        // Split leftover memory into the largest objects that fit so it isn't lost until the arena is destroyed
+        while (size_t(end - begin) >= Granularity) {
+            const auto size = std::min<size_t>(end - begin, MaxAllocationSize) / Granularity * Granularity;
+
+            this->addToFreeList(begin, getSizeClass(size));
+            begin += size;
+        }
+    }
+
+    void Arena::trim() {
+        // Keep the first slab around so a single object being created and destroyed over and over doesn't hit the system allocator
+        for (size_t i = 1; i < this->m_slabs.size(); i++)
+            ::operator delete(this->m_slabs[i], std::align_val_t(SlabSize));
+        this->m_slabs.resize(std::min<size_t>(this->m_slabs.size(), 1));
+
+        this->m_freeLists = { };
+        if (this->m_slabs.empty()) {
+            this->m_bumpPointer = this->m_bumpEnd = nullptr;
+        } else {
+            this->m_bumpPointer = reinterpret_cast<u8*>(this->m_slabs.front()) + getSlabHeaderSize();
+            this->m_bumpEnd = reinterpret_cast<u8*>(this->m_slabs.front()) + SlabSize;
+        }
+    }
+
+    Arena* Arena::getCurrent() {
+        return s_currentArena;
+    }
+
+    Arena::Scope::Scope(Arena *arena) : m_prevArena(s_currentArena) {
+        s_currentArena = arena;
+    }
+
+    Arena::Scope::~Scope() {
+        s_currentArena = this->m_prevArena;
+    }
+
+}
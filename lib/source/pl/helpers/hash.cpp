@@ -0,0 +1,298 @@
+#include <pl/helpers/hash.hpp>
+
+#include <algorithm>
+#include <bit>
+#include <cstring>
+
+namespace pl::hlp {
+
+    namespace {
+
+        [[nodiscard]] u32 readBigEndian32(const u8 *data) {
+            return (u32(data[0]) << 24) | (u32(data[1]) << 16) | (u32(data[2]) << 8) | u32(data[3]);
+        }
+
+        [[nodiscard]] u64 readLittleEndian64(const u8 *data) {
+            u64 result = 0;
+            for (size_t i = 0; i < sizeof(u64); i++)
+                result |= u64(data[i]) << (i * 8);
+
+            return result;
+        }
+
+        [[nodiscard]] u32 readLittleEndian32(const u8 *data) {
+            return u32(data[0]) | (u32(data[1]) << 8) | (u32(data[2]) << 16) | (u32(data[3]) << 24);
+        }
+
+        template<size_t Size>
+        [[nodiscard]] std::array<u8, Size> toBigEndianBytes(std::span<const u32> words) {
+            std::array<u8, Size> result = { };
+            for (size_t i = 0; i < words.size(); i++) {
+                for (size_t byte = 0; byte < sizeof(u32); byte++)
+                    result[i * sizeof(u32) + byte] = u8(words[i] >> (24 - byte * 8));
+            }
+
+            return result;
+        }
+
+        /**
+         * Feeds data to a hash working on fixed size blocks, buffering partial blocks between calls.
+         * Runs of whole blocks are passed on together so the hash can keep its state in registers while going through them
+         */
+        template<size_t BlockSize, typename ProcessBlocks>
+        void processBlocks(std::span<const u8> data, std::array<u8, BlockSize> &buffer, size_t &bufferSize, ProcessBlocks &&callback) {
+            if (bufferSize > 0) {
+                const auto count = std::min(BlockSize - bufferSize, data.size());
+                std::memcpy(buffer.data() + bufferSize, data.data(), count);
+                bufferSize += count;
+                data = data.subspan(count);
+
+                if (bufferSize < BlockSize)
+                    return;
+
+                callback(buffer.data(), 1);
+                bufferSize = 0;
+            }
+
+            const auto blockCount = data.size() / BlockSize;
+            if (blockCount > 0)
+                callback(data.data(), blockCount);
+
+            data = data.subspan(blockCount * BlockSize);
+            std::memcpy(buffer.data(), data.data(), data.size());
+            bufferSize = data.size();
+        }
+
+        /**
+         * Appends the padding and the message length in bits to the buffered data of a SHA-1 or SHA-256 hash
+         */
+        template<typename ProcessBlock>
+        void finishMerkleDamgard(std::array<u8, 64> buffer, size_t bufferSize, u64 totalSize, ProcessBlock &&processBlock) {
+            buffer[bufferSize++] = 0x80;
+            if (bufferSize > 56) {
+                std::fill(buffer.begin() + bufferSize, buffer.end(), 0x00);
+                processBlock(buffer.data());
+                bufferSize = 0;
+            }
+
+            std::fill(buffer.begin() + bufferSize, buffer.begin() + 56, 0x00);
+
+            const u64 bitCount = totalSize * 8;
+            for (size_t i = 0; i < sizeof(u64); i++)
+                buffer[56 + i] = u8(bitCount >> (56 - i * 8));
+
+            processBlock(buffer.data());
+        }
+
+        constexpr u64 XxPrime1 = 0x9E3779B185EBCA87;
+        constexpr u64 XxPrime2 = 0xC2B2AE3D27D4EB4F;
+        constexpr u64 XxPrime3 = 0x165667B19E3779F9;
+        constexpr u64 XxPrime4 = 0x85EBCA77C2B2AE63;
+        constexpr u64 XxPrime5 = 0x27D4EB2F165667C5;
+
+        [[nodiscard]] u64 xxRound(u64 accumulator, u64 input) {
+            accumulator += input * XxPrime2;
+            accumulator = std::rotl(accumulator, 31);
+            return accumulator * XxPrime1;
+        }
+
+        [[nodiscard]] u64 xxMergeRound(u64 accumulator, u64 value) {
+            accumulator ^= xxRound(0, value);
+            return accumulator * XxPrime1 + XxPrime4;
+        }
+
+        constexpr std::array<u32, 64> Sha256RoundConstants = {
+            0x428A2F98, 0x71374491, 0xB5C0FBCF, 0xE9B5DBA5, 0x3956C25B, 0x59F111F1, 0x923F82A4, 0xAB1C5ED5,
+            0xD807AA98, 0x12835B01, 0x243185BE, 0x550C7DC3, 0x72BE5D74, 0x80DEB1FE, 0x9BDC06A7, 0xC19BF174,
+            0xE49B69C1, 0xEFBE4786, 0x0FC19DC6, 0x240CA1CC, 0x2DE92C6F, 0x4A7484AA, 0x5CB0A9DC, 0x76F988DA,
+            0x983E5152, 0xA831C66D, 0xB00327C8, 0xBF597FC7, 0xC6E00BF3, 0xD5A79147, 0x06CA6351, 0x14292967,
+            0x27B70A85, 0x2E1B2138, 0x4D2C6DFC, 0x53380D13, 0x650A7354, 0x766A0ABB, 0x81C2C92E, 0x92722C85,
+            0xA2BFE8A1, 0xA81A664B, 0xC24B8B70, 0xC76C51A3, 0xD192E819, 0xD6990624, 0xF40E3585, 0x106AA070,
+            0x19A4C116, 0x1E376C08, 0x2748774C, 0x34B0BCB5, 0x391C0CB3, 0x4ED8AA4A, 0x5B9CCA4F, 0x682E6FF3,
+            0x748F82EE, 0x78A5636F, 0x84C87814, 0x8CC70208, 0x90BEFFFA, 0xA4506CEB, 0xBEF9A3F7, 0xC67178F2
+        };
+
+    }
+
+    void Adler32::process(std::span<const u8> data) {
+        constexpr static u32 Modulus = 65521;
+
+        // The largest number of bytes that can be summed up before the sums could overflow 32 bits
+        constexpr static size_t MaxBlockSize = 5552;
+
+        while (!data.empty()) {
+            const auto block = data.first(std::min(MaxBlockSize, data.size()));
+
+            for (const auto byte : block) {
+                this->m_a += byte;
+                this->m_b += this->m_a;
+            }
+
+            this->m_a %= Modulus;
+            this->m_b %= Modulus;
+
+            data = data.subspan(block.size());
+        }
+    }
+
+    XxHash64::XxHash64(u64 seed) : m_seed(seed) {
+        this->m_lanes = { seed + XxPrime1 + XxPrime2, seed + XxPrime2, seed, seed - XxPrime1 };
+    }
+
+    void XxHash64::process(std::span<const u8> data) {
+        this->m_totalSize += data.size();
+
+        processBlocks(data, this->m_buffer, this->m_bufferSize, [this](const u8 *blocks, size_t count) {
+            auto lanes = this->m_lanes;
+            for (size_t block = 0; block < count; block++) {
+                for (size_t lane = 0; lane < lanes.size(); lane++)
+                    lanes[lane] = xxRound(lanes[lane], readLittleEndian64(blocks + block * this->m_buffer.size() + lane * sizeof(u64)));
+            }
+
+            this->m_lanes = lanes;
+        });
+    }
+
+    u64 XxHash64::getResult() const {
+        u64 result;
+        if (this->m_totalSize >= this->m_buffer.size()) {
+            const auto &lanes = this->m_lanes;
+            result = std::rotl(lanes[0], 1) + std::rotl(lanes[1], 7) + std::rotl(lanes[2], 12) + std::rotl(lanes[3], 18);
+
+            for (const auto lane : lanes)
+                result = xxMergeRound(result, lane);
+        } else {
+            result = this->m_seed + XxPrime5;
+        }
+
+        result += this->m_totalSize;
+
+        const u8 *remaining = this->m_buffer.data();
+        const u8 *end = remaining + this->m_bufferSize;
+
+        for (; remaining + sizeof(u64) <= end; remaining += sizeof(u64))
+            result = std::rotl(result ^ xxRound(0, readLittleEndian64(remaining)), 27) * XxPrime1 + XxPrime4;
+        for (; remaining + sizeof(u32) <= end; remaining += sizeof(u32))
+            result = std::rotl(result ^ (u64(readLittleEndian32(remaining)) * XxPrime1), 23) * XxPrime2 + XxPrime3;
+        for (; remaining < end; remaining++)
+            result = std::rotl(result ^ (*remaining * XxPrime5), 11) * XxPrime1;
+
+        result ^= result >> 33;
+        result *= XxPrime2;
+        result ^= result >> 29;
+        result *= XxPrime3;
+        result ^= result >> 32;
+
+        return result;
+    }
+
+    void Sha1::processBlock(const u8 *block) {
+        std::array<u32, 80> words;
+        for (size_t i = 0; i < 16; i++)
+            words[i] = readBigEndian32(block + i * sizeof(u32));
+        for (size_t i = 16; i < words.size(); i++)
+            words[i] = std::rotl(words[i - 3] ^ words[i - 8] ^ words[i - 14] ^ words[i - 16], 1);
+
+        auto [a, b, c, d, e] = this->m_state;
+        for (size_t i = 0; i < words.size(); i++) {
+            u32 f, k;
+            if (i < 20) {
+                f = (b & c) | (~b & d);
+                k = 0x5A827999;
+            } else if (i < 40) {
+                f = b ^ c ^ d;
+                k = 0x6ED9EBA1;
+            } else if (i < 60) {
+                f = (b & c) | (b & d) | (c & d);
+                k = 0x8F1BBCDC;
+            } else {
+                f = b ^ c ^ d;
+                k = 0xCA62C1D6;
+            }
+
+            const u32 temp = std::rotl(a, 5) + f + e + k + words[i];
+            e = d;
+            d = c;
+            c = std::rotl(b, 30);
+            b = a;
+            a = temp;
+        }
+
+        this->m_state[0] += a;
+        this->m_state[1] += b;
+        this->m_state[2] += c;
+        this->m_state[3] += d;
+        this->m_state[4] += e;
+    }
+
+    void Sha1::process(std::span<const u8> data) {
+        this->m_totalSize += data.size();
+
+        processBlocks(data, this->m_buffer, this->m_bufferSize, [this](const u8 *blocks, size_t count) {
+            for (size_t block = 0; block < count; block++)
+                this->processBlock(blocks + block * this->m_buffer.size());
+        });
+    }
+
+    std::array<u8, 20> Sha1::getResult() const {
+        auto copy = *this;
+        finishMerkleDamgard(copy.m_buffer, copy.m_bufferSize, copy.m_totalSize, [&copy](const u8 *block) {
+            copy.processBlock(block);
+        });
+
+        return toBigEndianBytes<20>(copy.m_state);
+    }
+
+    void Sha256::processBlock(const u8 *block) {
+        std::array<u32, 64> words;
+        for (size_t i = 0; i < 16; i++)
+            words[i] = readBigEndian32(block + i * sizeof(u32));
+        for (size_t i = 16; i < words.size(); i++) {
+            const u32 s0 = std::rotr(words[i - 15], 7) ^ std::rotr(words[i - 15], 18) ^ (words[i - 15] >> 3);
+            const u32 s1 = std::rotr(words[i - 2], 17) ^ std::rotr(words[i - 2], 19) ^ (words[i - 2] >> 10);
+            words[i] = words[i - 16] + s0 + words[i - 7] + s1;
+        }
+
+        auto [a, b, c, d, e, f, g, h] = this->m_state;
+        for (size_t i = 0; i < words.size(); i++) {
+            const u32 s1     = std::rotr(e, 6) ^ std::rotr(e, 11) ^ std::rotr(e, 25);
+            const u32 choose = (e & f) ^ (~e & g);
+            const u32 temp1  = h + s1 + choose + Sha256RoundConstants[i] + words[i];
+            const u32 s0     = std::rotr(a, 2) ^ std::rotr(a, 13) ^ std::rotr(a, 22);
+            const u32 major  = (a & b) ^ (a & c) ^ (b & c);
+            const u32 temp2  = s0 + major;
+
+            h = g;
+            g = f;
+            f = e;
+            e = d + temp1;
+            d = c;
+            c = b;
+            b = a;
+            a = temp1 + temp2;
+        }
+
+        const std::array<u32, 8> result = { a, b, c, d, e, f, g, h };
+        for (size_t i = 0; i < this->m_state.size(); i++)
+            this->m_state[i] += result[i];
+    }
+
+    void Sha256::process(std::span<const u8> data) {
+        this->m_totalSize += data.size();
+
+        processBlocks(data, this->m_buffer, this->m_bufferSize, [this](const u8 *blocks, size_t count) {
+            for (size_t block = 0; block < count; block++)
+                this->processBlock(blocks + block * this->m_buffer.size());
+        });
+    }
+
+    std::array<u8, 32> Sha256::getResult() const {
+        auto copy = *this;
+        finishMerkleDamgard(copy.m_buffer, copy.m_bufferSize, copy.m_totalSize, [&copy](const u8 *block) {
+            copy.processBlock(block);
+        });
+
+        return toBigEndianBytes<32>(copy.m_state);
+    }
+
+}
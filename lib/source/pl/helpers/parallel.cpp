@@ -0,0 +1,136 @@
+#include <pl/helpers/parallel.hpp>
+
+#include <pl/helpers/arena.hpp>
+
+#include <algorithm>
+#include <exception>
+
+namespace pl::hlp {
+
+    struct ThreadPool::Job {
+        Job(size_t count, Task task, void *context, Arena *arena) : count(count), task(task), context(context), arena(arena) { }
+
+        size_t count;
+        Task task;
+        void *context;
+        Arena *arena;
+
+        std::atomic<size_t> nextIndex = 0;
+        std::atomic<bool> failed = false;
+        std::exception_ptr exception;
+        std::mutex exceptionMutex;
+
+        // Number of workers currently processing indices of this job, guarded by the pool mutex
+        size_t activeWorkers = 0;
+
+        [[nodiscard]] bool hasWork() const {
+            return !this->failed && this->nextIndex < this->count;
+        }
+
+        void work() {
+            Arena::Scope arenaScope(this->arena);
+
+            while (!this->failed) {
+                const auto index = this->nextIndex.fetch_add(1);
+                if (index >= this->count)
+                    break;
+
+                try {
+                    this->task(this->context, index);
+                } catch (...) {
+                    std::scoped_lock lock(this->exceptionMutex);
+                    if (this->exception == nullptr)
+                        this->exception = std::current_exception();
+
+                    this->failed = true;
+                }
+            }
+        }
+    };
+
+    ThreadPool& ThreadPool::getInstance() {
+        static ThreadPool pool;
+
+        return pool;
+    }
+
+    ThreadPool::ThreadPool() {
+        const auto workerCount = std::max(1U, std::thread::hardware_concurrency()) - 1;
+
+        this->m_workers.reserve(workerCount);
+        for (size_t i = 0; i < workerCount; i++)
+            this->m_workers.emplace_back([this] { this->workerLoop(); });
+    }
+
+    ThreadPool::~ThreadPool() {
+        {
+            std::scoped_lock lock(this->m_mutex);
+            this->m_stopping = true;
+        }
+
+        this->m_jobAdded.notify_all();
+
+        for (auto &worker : this->m_workers)
+            worker.join();
+    }
+
+    ThreadPool::Job* ThreadPool::findJob() const {
+        // Jobs stay queued until their caller is done with them, so skip the ones that have already been handed out completely
+        for (const auto job : this->m_jobs) {
+            if (job->hasWork())
+                return job;
+        }
+
+        return nullptr;
+    }
+
+    void ThreadPool::workerLoop() {
+        std::unique_lock lock(this->m_mutex);
+
+        while (true) {
+            this->m_jobAdded.wait(lock, [this] { return this->m_stopping || this->findJob() != nullptr; });
+            if (this->m_stopping)
+                return;
+
+            auto job = this->findJob();
+            job->activeWorkers += 1;
+
+            lock.unlock();
+            job->work();
+            lock.lock();
+
+            job->activeWorkers -= 1;
+            if (job->activeWorkers == 0)
+                this->m_workerLeft.notify_all();
+        }
+    }
+
+    void ThreadPool::run(size_t count, Task task, void *context) {
+        if (count == 0)
+            return;
+
+        Job job(count, task, context, Arena::getCurrent());
+
+        if (count == 1 || this->m_workers.empty()) {
+            job.work();
+        } else {
+            {
+                std::scoped_lock lock(this->m_mutex);
+                this->m_jobs.push_back(&job);
+            }
+
+            this->m_jobAdded.notify_all();
+
+            job.work();
+
+            // The job lives on this stack frame, so wait for every worker that picked it up to let go of it
+            std::unique_lock lock(this->m_mutex);
+            std::erase(this->m_jobs, &job);
+            this->m_workerLeft.wait(lock, [&job] { return job.activeWorkers == 0; });
+        }
+
+        if (job.exception != nullptr)
+            std::rethrow_exception(job.exception);
+    }
+
+}
@@ -0,0 +1,157 @@
+#include <pl/helpers/signature_scanner.hpp>
+
+#include <pl/core/errors/evaluator_errors.hpp>
+
+#include <fmt/format.h>
+
+#include <algorithm>
+#include <bit>
+#include <cctype>
+
+namespace pl::hlp {
+
+    namespace {
+
+        struct SignatureByte {
+            u8 value, mask;
+        };
+
+        std::vector<SignatureByte> parseSignature(const std::string &signature) {
+            std::string digits;
+            for (char c : signature) {
+                if (std::isspace(static_cast<unsigned char>(c)))
+                    continue;
+
+                if (c != '?' && !std::isxdigit(static_cast<unsigned char>(c)))
+                    core::err::E0012.throwError(fmt::format("Invalid character '{}' in signature '{}'.", c, signature), "Signatures consist of hex bytes. Use '?' to match any nibble.");
+
+                digits.push_back(c);
+            }
+
+            if (digits.empty() || digits.size() % 2 != 0)
+                core::err::E0012.throwError(fmt::format("Invalid signature '{}'.", signature), "Signatures need to consist of one or more whole bytes, for example \"4D 5A ?? ?? 50 45\".");
+
+            std::vector<SignatureByte> result;
+            for (size_t i = 0; i < digits.size(); i += 2) {
+                SignatureByte byte = { 0x00, 0x00 };
+
+                for (size_t nibble = 0; nibble < 2; nibble++) {
+                    const char c = digits[i + nibble];
+                    const u8 shift = nibble == 0 ? 4 : 0;
+
+                    if (c == '?')
+                        continue;
+
+                    const u8 value = std::isdigit(static_cast<unsigned char>(c)) ? c - '0' : std::toupper(static_cast<unsigned char>(c)) - 'A' + 10;
+                    byte.value |= value << shift;
+                    byte.mask  |= 0x0F << shift;
+                }
+
+                result.push_back(byte);
+            }
+
+            if (result.size() > SignatureScanner::MaxSignatureSize)
+                core::err::E0012.throwError(fmt::format("Signature '{}' is {} bytes long.", signature, result.size()), fmt::format("Signatures can be at most {} bytes long.", SignatureScanner::MaxSignatureSize));
+
+            return result;
+        }
+
+    }
+
+    SignatureScanner::SignatureScanner(const std::vector<std::string> &signatures) {
+        std::vector<std::vector<SignatureByte>> parsed;
+        parsed.reserve(signatures.size());
+        for (const auto &signature : signatures)
+            parsed.push_back(parseSignature(signature));
+
+        // Signatures are packed into words without ever crossing a word boundary
+        struct Placement { size_t word, bit; };
+        std::vector<Placement> placements;
+        size_t usedBits = 64;
+        for (const auto &signature : parsed) {
+            if (usedBits + signature.size() > 64) {
+                this->m_wordCount++;
+                usedBits = 0;
+            }
+
+            placements.push_back({ this->m_wordCount - 1, usedBits });
+            usedBits += signature.size();
+        }
+
+        this->m_byteMasks.resize(256 * this->m_wordCount, 0);
+        this->m_startMasks.resize(this->m_wordCount, 0);
+        this->m_endMasks.resize(this->m_wordCount, 0);
+        this->m_state.resize(this->m_wordCount, 0);
+        this->m_bitSignatures.resize(64 * this->m_wordCount, 0);
+
+        for (u32 index = 0; index < parsed.size(); index++) {
+            const auto &signature = parsed[index];
+            const auto [word, firstBit] = placements[index];
+
+            this->m_startMasks[word] |= u64(1) << firstBit;
+            this->m_endMasks[word]   |= u64(1) << (firstBit + signature.size() - 1);
+            this->m_bitSignatures[word * 64 + firstBit + signature.size() - 1] = index;
+            this->m_signatureSizes.push_back(signature.size());
+
+            for (size_t i = 0; i < signature.size(); i++) {
+                for (u32 value = 0; value < 256; value++) {
+                    if ((value & signature[i].mask) == signature[i].value)
+                        this->m_byteMasks[value * this->m_wordCount + word] |= u64(1) << (firstBit + i);
+                }
+            }
+        }
+    }
+
+    void SignatureScanner::addHits(u64 address, size_t word, u64 bits, std::vector<Hit> &hits) const {
+        while (bits != 0) {
+            const auto bit = std::countr_zero(bits);
+            bits &= bits - 1;
+
+            const auto signature = this->m_bitSignatures[word * 64 + bit];
+            hits.push_back({ address + 1 - this->m_signatureSizes[signature], signature });
+        }
+    }
+
+    void SignatureScanner::scan(u64 address, std::span<const u8> data, std::vector<Hit> &hits) {
+        const auto wordCount = this->m_wordCount;
+
+        if (wordCount == 1) {
+            // Keep the state in a register for the common case of only a few short signatures
+            u64 state = this->m_state.front();
+            const u64 start = this->m_startMasks.front(), end = this->m_endMasks.front();
+
+            for (size_t i = 0; i < data.size(); i++) {
+                state = ((state << 1) | start) & this->m_byteMasks[data[i]];
+
+                if ((state & end) != 0) [[unlikely]]
+                    this->addHits(address + i, 0, state & end, hits);
+            }
+
+            this->m_state.front() = state;
+        } else {
+            auto state = this->m_state.data();
+            const auto start = this->m_startMasks.data(), end = this->m_endMasks.data();
+
+            for (size_t i = 0; i < data.size(); i++) {
+                const auto masks = &this->m_byteMasks[data[i] * wordCount];
+
+                // Words are independent of each other, which lets this loop be vectorized
+                u64 found = 0;
+                for (size_t word = 0; word < wordCount; word++) {
+                    state[word] = ((state[word] << 1) | start[word]) & masks[word];
+                    found |= state[word] & end[word];
+                }
+
+                if (found != 0) [[unlikely]] {
+                    for (size_t word = 0; word < wordCount; word++)
+                        this->addHits(address + i, word, state[word] & end[word], hits);
+                }
+            }
+        }
+    }
+
+    void SignatureScanner::reset() {
+        std::fill(this->m_state.begin(), this->m_state.end(), 0);
+    }
+
+}
@@ -0,0 +1,70 @@
+#include <pl/helpers/stream_window.hpp>
+
+#include <pl/core/errors/evaluator_errors.hpp>
+
+#include <fmt/format.h>
+
+#include <algorithm>
+#include <cstring>
+
+namespace pl::hlp {
+
+    namespace {
+
+        constexpr size_t MinimumPullSize = 64 * 1024;
+
+    }
+
+    StreamWindow::StreamWindow(ReadFunction readFunction, size_t windowSize)
+        : m_readFunction(std::move(readFunction)), m_windowSize(std::max<size_t>(windowSize, MinimumPullSize)) { }
+
+    void StreamWindow::read(u64 address, u8 *buffer, size_t size) {
+        if (size == 0)
+            return;
+
+        if (address < this->m_windowStart)
+            core::err::E0011.throwError(
+                fmt::format("Tried reading address 0x{:X} of a stream that only keeps data starting at 0x{:X}.", address, this->m_windowStart),
+                "Streams can't seek backwards past their window. Try increasing the window size."
+            );
+
+        this->pull(address, address + size);
+
+        const auto end       = this->getPulledSize();
+        const auto available = address < end ? std::min<u64>(size, end - address) : 0;
+
+        std::memcpy(buffer, this->m_buffer.data() + (address - this->m_windowStart), available);
+        std::memset(buffer + available, 0x00, size - available);
+    }
+
+    bool StreamWindow::hasDataAt(u64 address) {
+        this->pull(address, address + 1);
+
+        return address < this->getPulledSize();
+    }
+
+    void StreamWindow::pull(u64 start, u64 end) {
+        while (!this->m_endReached && this->getPulledSize() < end) {
+            const auto pullSize = std::max<size_t>(end - this->getPulledSize(), MinimumPullSize);
+
+            const auto previousSize = this->m_buffer.size();
+            this->m_buffer.resize(previousSize + pullSize);
+
+            const auto readSize = this->m_readFunction(this->m_buffer.data() + previousSize, pullSize);
+            this->m_buffer.resize(previousSize + std::min(readSize, pullSize));
+
+            if (readSize == 0)
+                this->m_endReached = true;
+        }
+
+        // Drop old data once the buffer holds twice the window size so data only gets moved every so often.
+        // Data from the start of the requested range onwards is always kept
+        if (this->m_buffer.size() > this->m_windowSize * 2) {
+            const auto dropSize = std::min<u64>(this->m_buffer.size() - this->m_windowSize, std::max(start, this->m_windowStart) - this->m_windowStart);
+
+            this->m_buffer.erase(this->m_buffer.begin(), this->m_buffer.begin() + dropSize);
+            this->m_windowStart += dropSize;
+        }
+    }
+
+}
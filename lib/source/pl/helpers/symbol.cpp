@@ -0,0 +1,46 @@
+#include <pl/helpers/symbol.hpp>
+
+#include <array>
+#include <functional>
+#include <mutex>
+#include <unordered_set>
+
+namespace pl::hlp {
+
+    namespace {
+
+        struct SymbolHash {
+            using is_transparent = void;
+
+            [[nodiscard]] size_t operator()(std::string_view string) const {
+                return std::hash<std::string_view>()(string);
+            }
+        };
+
+        // Every shard has its own lock, so threads creating patterns at the same time rarely wait on each other
+        struct alignas(64) SymbolShard {
+            std::mutex mutex;
+            std::unordered_set<std::string, SymbolHash, std::equal_to<>> symbols;
+        };
+
+        constexpr static size_t ShardCount = 64;
+
+    }
+
+    const std::string* Symbol::intern(std::string_view string) {
+        static std::array<SymbolShard, ShardCount> shards;
+
+        const auto hash = SymbolHash()(string);
+        auto &shard = shards[(hash >> 8) % ShardCount];
+
+        std::scoped_lock lock(shard.mutex);
+
+        // Lookups don't need a copy of the string, only symbols seen for the first time get stored
+        if (auto it = shard.symbols.find(string); it != shard.symbols.end())
+            return &*it;
+
+        // Set nodes never move, so pointers to the stored strings stay valid for the lifetime of the process
+        return &*shard.symbols.emplace(string).first;
+    }
+
+}
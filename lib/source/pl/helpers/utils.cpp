@@ -1,11 +1,277 @@
 #include <pl/helpers/utils.hpp>
 
+#include <algorithm>
 #include <codecvt>
+#include <functional>
+#include <limits>
 
 #include <fmt/format.h>
 
+#if defined(__x86_64__) && defined(__GNUC__)
+    #include <immintrin.h>
+#endif
+
 namespace pl::hlp {
 
+    namespace {
+
+        template<size_t Size>
+        void swapByteOrderScalar(u8 *data, size_t count) {
+            for (size_t i = 0; i < count; i++) {
+                SizeType<Size> value;
+                std::memcpy(&value, data + i * Size, Size);
+                value = std::byteswap(value);
+                std::memcpy(data + i * Size, &value, Size);
+            }
+        }
+
+        void float16ToFloat32Scalar(const u16 *values, float *result, size_t count) {
+            for (size_t i = 0; i < count; i++)
+                result[i] = float16ToFloat32(values[i]);
+        }
+
+#if defined(__x86_64__) && defined(__GNUC__)
+
+        [[nodiscard]] bool isAVX2Supported() {
+            static const bool supported = __builtin_cpu_supports("avx2");
+
+            return supported;
+        }
+
+        [[nodiscard]] bool isAVX2AndPopCountSupported() {
+            static const bool supported = isAVX2Supported() && __builtin_cpu_supports("popcnt");
+
+            return supported;
+        }
+
+        template<size_t Size>
+        void swapByteOrderSSE2(u8 *data, size_t count) {
+            const auto vectorCount = count * Size / sizeof(__m128i);
+
+            for (size_t i = 0; i < vectorCount; i++) {
+                auto address = reinterpret_cast<__m128i*>(data + i * sizeof(__m128i));
+                auto vector = _mm_loadu_si128(address);
+
+                // SSE2 can't shuffle bytes, so the 16 bit words get reversed first and the bytes inside of them afterwards
+                if constexpr (Size == 4) {
+                    vector = _mm_shufflehi_epi16(_mm_shufflelo_epi16(vector, 0b10'11'00'01), 0b10'11'00'01);
+                } else if constexpr (Size == 8) {
+                    vector = _mm_shufflehi_epi16(_mm_shufflelo_epi16(vector, 0b00'01'10'11), 0b00'01'10'11);
+                }
+
+                vector = _mm_or_si128(_mm_slli_epi16(vector, 8), _mm_srli_epi16(vector, 8));
+                _mm_storeu_si128(address, vector);
+            }
+
+            const auto processed = vectorCount * sizeof(__m128i) / Size;
+            swapByteOrderScalar<Size>(data + processed * Size, count - processed);
+        }
+
+        template<size_t Size>
+        __attribute__((target("avx2"))) void swapByteOrderAVX2(u8 *data, size_t count) {
+            alignas(32) std::array<u8, 32> indices = { };
+            for (u8 i = 0; i < indices.size(); i++)
+                indices[i] = ((i % 16) / Size) * Size + (Size - 1 - i % Size);
+
+            const auto shuffle = _mm256_load_si256(reinterpret_cast<const __m256i*>(indices.data()));
+            const auto vectorCount = count * Size / sizeof(__m256i);
+
+            for (size_t i = 0; i < vectorCount; i++) {
+                auto address = reinterpret_cast<__m256i*>(data + i * sizeof(__m256i));
+                _mm256_storeu_si256(address, _mm256_shuffle_epi8(_mm256_loadu_si256(address), shuffle));
+            }
+
+            const auto processed = vectorCount * sizeof(__m256i) / Size;
+            swapByteOrderScalar<Size>(data + processed * Size, count - processed);
+        }
+
+        /*
+         * Half precision floats are converted by moving their exponent and mantissa into place and multiplying with a
+         * power of two that corrects the exponent bias. This also normalizes subnormal values. Infinities and NaNs
+         * only need their exponent to be set to all ones
+         */
+
+        constexpr static u32 Float16ExponentAdjust = (254 - 15) << 23;
+        constexpr static u32 Float16MaximumFinite  = 0x7BFF;
+        constexpr static u32 Float32ExponentMask   = 0xFF << 23;
+
+        void float16ToFloat32SSE2(const u16 *values, float *result, size_t count) {
+            const auto zero         = _mm_setzero_si128();
+            const auto noSignMask   = _mm_set1_epi32(0x7FFF);
+            const auto adjust       = _mm_castsi128_ps(_mm_set1_epi32(Float16ExponentAdjust));
+            const auto maxFinite    = _mm_set1_epi32(Float16MaximumFinite);
+            const auto infNaN       = _mm_castsi128_ps(_mm_set1_epi32(Float32ExponentMask));
+
+            const auto vectorCount = count / 4;
+            for (size_t i = 0; i < vectorCount; i++) {
+                const auto halfs    = _mm_unpacklo_epi16(_mm_loadl_epi64(reinterpret_cast<const __m128i*>(values + i * 4)), zero);
+                const auto noSign   = _mm_and_si128(halfs, noSignMask);
+                const auto sign     = _mm_slli_epi32(_mm_xor_si128(halfs, noSign), 16);
+
+                const auto scaled   = _mm_mul_ps(_mm_castsi128_ps(_mm_slli_epi32(noSign, 13)), adjust);
+                const auto exponent = _mm_and_ps(_mm_castsi128_ps(_mm_cmpgt_epi32(noSign, maxFinite)), infNaN);
+
+                _mm_storeu_ps(result + i * 4, _mm_or_ps(scaled, _mm_or_ps(_mm_castsi128_ps(sign), exponent)));
+            }
+
+            float16ToFloat32Scalar(values + vectorCount * 4, result + vectorCount * 4, count - vectorCount * 4);
+        }
+
+        __attribute__((target("avx2"))) void float16ToFloat32AVX2(const u16 *values, float *result, size_t count) {
+            const auto noSignMask   = _mm256_set1_epi32(0x7FFF);
+            const auto adjust       = _mm256_castsi256_ps(_mm256_set1_epi32(Float16ExponentAdjust));
+            const auto maxFinite    = _mm256_set1_epi32(Float16MaximumFinite);
+            const auto infNaN       = _mm256_castsi256_ps(_mm256_set1_epi32(Float32ExponentMask));
+
+            const auto vectorCount = count / 8;
+            for (size_t i = 0; i < vectorCount; i++) {
+                const auto halfs    = _mm256_cvtepu16_epi32(_mm_loadu_si128(reinterpret_cast<const __m128i*>(values + i * 8)));
+                const auto noSign   = _mm256_and_si256(halfs, noSignMask);
+                const auto sign     = _mm256_slli_epi32(_mm256_xor_si256(halfs, noSign), 16);
+
+                const auto scaled   = _mm256_mul_ps(_mm256_castsi256_ps(_mm256_slli_epi32(noSign, 13)), adjust);
+                const auto exponent = _mm256_and_ps(_mm256_castsi256_ps(_mm256_cmpgt_epi32(noSign, maxFinite)), infNaN);
+
+                _mm256_storeu_ps(result + i * 8, _mm256_or_ps(scaled, _mm256_or_ps(_mm256_castsi256_ps(sign), exponent)));
+            }
+
+            float16ToFloat32Scalar(values + vectorCount * 8, result + vectorCount * 8, count - vectorCount * 8);
+        }
+
+#endif
+
+        [[nodiscard]] InstructionSet getDefaultInstructionSet() {
+            #if defined(__x86_64__) && defined(__GNUC__)
+                return isAVX2Supported() ? InstructionSet::AVX2 : InstructionSet::SSE2;
+            #else
+                return InstructionSet::Scalar;
+            #endif
+        }
+
+        template<size_t Size>
+        void swapByteOrder(u8 *data, size_t count, InstructionSet instructionSet) {
+            switch (instructionSet) {
+            #if defined(__x86_64__) && defined(__GNUC__)
+                case InstructionSet::AVX2:
+                    swapByteOrderAVX2<Size>(data, count);
+                    break;
+                case InstructionSet::SSE2:
+                    swapByteOrderSSE2<Size>(data, count);
+                    break;
+            #endif
+                default:
+                    swapByteOrderScalar<Size>(data, count);
+                    break;
+            }
+        }
+
+        /*
+         * Reductions keep one accumulator per value of a 64 byte block. The inner loop has a fixed trip count and its
+         * lanes don't depend on each other, so the compiler turns it into vector instructions as wide as the target of
+         * the function it gets inlined into allows
+         */
+
+        constexpr static size_t ReductionBlockSize = 64;
+
+        // Sums of up to this many 32 bit values can't overflow their 64 bit accumulators
+        constexpr static u64 MaxSumCount = u64(1) << 32;
+
+        template<typename T, typename Accumulator, typename Transform, typename Operation>
+        [[gnu::always_inline]] inline Accumulator reduceLanes(const u8 *data, size_t count, Accumulator identity, Transform transform, Operation operation) {
+            constexpr size_t Lanes = ReductionBlockSize / sizeof(T);
+
+            std::array<Accumulator, Lanes> lanes;
+            lanes.fill(identity);
+
+            size_t i = 0;
+            for (; i + Lanes <= count; i += Lanes) {
+                for (size_t lane = 0; lane < Lanes; lane++) {
+                    T value;
+                    std::memcpy(&value, data + (i + lane) * sizeof(T), sizeof(T));
+                    lanes[lane] = operation(lanes[lane], transform(value));
+                }
+            }
+
+            for (; i < count; i++) {
+                T value;
+                std::memcpy(&value, data + i * sizeof(T), sizeof(T));
+                lanes[0] = operation(lanes[0], transform(value));
+            }
+
+            Accumulator result = identity;
+            for (const auto &lane : lanes)
+                result = operation(result, lane);
+
+            return result;
+        }
+
+        template<typename T>
+        [[gnu::always_inline]] inline u128 reduceValues(const u8 *data, size_t count, ReductionOperation operation) {
+            const auto unchanged = [](T value) { return value; };
+
+            switch (operation) {
+                case ReductionOperation::Sum: {
+                    u128 result = 0;
+                    for (u64 start = 0; start < count; start += MaxSumCount) {
+                        const auto blockData  = data + start * sizeof(T);
+                        const auto blockCount = std::min<u64>(MaxSumCount, count - start);
+
+                        if constexpr (sizeof(T) == sizeof(u64)) {
+                            // The halves of 64 bit values are summed separately so the accumulators can't overflow
+                            result += reduceLanes<T, u64>(blockData, blockCount, 0, [](T value) { return value & 0xFFFF'FFFF; }, std::plus<u64>());
+                            result += u128(reduceLanes<T, u64>(blockData, blockCount, 0, [](T value) { return value >> 32; }, std::plus<u64>())) << 32;
+                        } else {
+                            result += reduceLanes<T, u64>(blockData, blockCount, 0, [](T value) { return u64(value); }, std::plus<u64>());
+                        }
+                    }
+
+                    return result;
+                }
+                case ReductionOperation::Minimum:
+                    return reduceLanes<T, T>(data, count, std::numeric_limits<T>::max(), unchanged, [](T a, T b) { return std::min(a, b); });
+                case ReductionOperation::Maximum:
+                    return reduceLanes<T, T>(data, count, std::numeric_limits<T>::min(), unchanged, [](T a, T b) { return std::max(a, b); });
+                case ReductionOperation::Xor:
+                    return reduceLanes<T, T>(data, count, 0, unchanged, std::bit_xor<T>());
+                case ReductionOperation::PopCount: {
+                    // The number of set bits doesn't depend on how the bytes are grouped into values
+                    const auto size = count * sizeof(T);
+
+                    u128 result = reduceLanes<u64, u64>(data, size / sizeof(u64), 0, [](u64 value) { return u64(std::popcount(value)); }, std::plus<u64>());
+                    for (size_t i = size - size % sizeof(u64); i < size; i++)
+                        result += std::popcount(data[i]);
+
+                    return result;
+                }
+            }
+
+            return 0;
+        }
+
+        [[gnu::always_inline]] inline u128 reduceBySize(const u8 *data, size_t valueSize, size_t count, ReductionOperation operation) {
+            switch (valueSize) {
+                case 1: return reduceValues<u8>(data, count, operation);
+                case 2: return reduceValues<u16>(data, count, operation);
+                case 4: return reduceValues<u32>(data, count, operation);
+                case 8: return reduceValues<u64>(data, count, operation);
+                default: return 0;
+            }
+        }
+
+        u128 reduceDefault(const u8 *data, size_t valueSize, size_t count, ReductionOperation operation) {
+            return reduceBySize(data, valueSize, count, operation);
+        }
+
+#if defined(__x86_64__) && defined(__GNUC__)
+
+        __attribute__((target("avx2,popcnt"))) u128 reduceAVX2(const u8 *data, size_t valueSize, size_t count, ReductionOperation operation) {
+            return reduceBySize(data, valueSize, count, operation);
+        }
+
+#endif
+
+    }
+
     std::string to_string(u128 value) {
         return fmt::format("{}", value);
     }
@@ -92,4 +358,102 @@ namespace pl::hlp {
 
         return floatResult;
     }
-}
\ No newline at end of file
+
+    std::vector<InstructionSet> getSupportedInstructionSets() {
+        std::vector<InstructionSet> result = { InstructionSet::Scalar };
+        if (getDefaultInstructionSet() != InstructionSet::Scalar)
+            result.push_back(InstructionSet::SSE2);
+        if (getDefaultInstructionSet() == InstructionSet::AVX2)
+            result.push_back(InstructionSet::AVX2);
+
+        return result;
+    }
+
+    void swapByteOrder(void *data, size_t valueSize, size_t count) {
+        swapByteOrder(data, valueSize, count, getDefaultInstructionSet());
+    }
+
+    void swapByteOrder(void *data, size_t valueSize, size_t count, InstructionSet instructionSet) {
+        auto bytes = static_cast<u8*>(data);
+
+        switch (valueSize) {
+            case 1:
+                break;
+            case 2:
+                swapByteOrder<2>(bytes, count, instructionSet);
+                break;
+            case 4:
+                swapByteOrder<4>(bytes, count, instructionSet);
+                break;
+            case 8:
+                swapByteOrder<8>(bytes, count, instructionSet);
+                break;
+            default:
+                for (size_t i = 0; i < count; i++)
+                    std::reverse(bytes + i * valueSize, bytes + (i + 1) * valueSize);
+                break;
+        }
+    }
+
+    void float16ToFloat32(std::span<const u16> values, std::span<float> result) {
+        float16ToFloat32(values, result, getDefaultInstructionSet());
+    }
+
+    void float16ToFloat32(std::span<const u16> values, std::span<float> result, InstructionSet instructionSet) {
+        const auto count = std::min(values.size(), result.size());
+
+        switch (instructionSet) {
+        #if defined(__x86_64__) && defined(__GNUC__)
+            case InstructionSet::AVX2:
+                float16ToFloat32AVX2(values.data(), result.data(), count);
+                break;
+            case InstructionSet::SSE2:
+                float16ToFloat32SSE2(values.data(), result.data(), count);
+                break;
+        #endif
+            default:
+                float16ToFloat32Scalar(values.data(), result.data(), count);
+                break;
+        }
+    }
+
+    u128 reduce(const void *data, size_t valueSize, size_t count, ReductionOperation operation) {
+        const auto bytes = static_cast<const u8*>(data);
+
+        #if defined(__x86_64__) && defined(__GNUC__)
+            if (isAVX2AndPopCountSupported())
+                return reduceAVX2(bytes, valueSize, count, operation);
+        #endif
+
+        return reduceDefault(bytes, valueSize, count, operation);
+    }
+
+    void addToByteHistogram(std::span<const u8> data, std::array<u64, 256> &histogram) {
+        // Neighbouring bytes are counted in separate tables so runs of the same value don't wait on each other's increments
+        constexpr static size_t TableCount = 8;
+        constexpr static size_t BlockSize = size_t(1) << 32;
+
+        std::array<std::array<u32, 256>, TableCount> tables;
+        for (size_t start = 0; start < data.size(); start += BlockSize) {
+            const auto block = data.subspan(start, std::min(BlockSize, data.size() - start));
+
+            for (auto &table : tables)
+                table.fill(0);
+
+            size_t i = 0;
+            for (; i + TableCount <= block.size(); i += TableCount) {
+                for (size_t table = 0; table < TableCount; table++)
+                    tables[table][block[i + table]]++;
+            }
+
+            for (; i < block.size(); i++)
+                tables[0][block[i]]++;
+
+            for (size_t value = 0; value < histogram.size(); value++) {
+                for (const auto &table : tables)
+                    histogram[value] += table[value];
+            }
+        }
+    }
+
+}
@@ -4,11 +4,67 @@
 #include <pl/core/log_console.hpp>
 #include <pl/core/evaluator.hpp>
 #include <pl/patterns/pattern.hpp>
+#include <pl/patterns/pattern_array_static.hpp>
 
-#include <wolv/hash/crc.hpp>
+#include <pl/helpers/hash.hpp>
+
+#include <fmt/format.h>
 
 namespace pl::lib::libstd::hash {
 
+    constexpr static u64 ChunkSize = 0x100000;
+
+    /**
+     * @brief Checks if the bytes Pattern::getBytes() returns for a pattern are exactly the data it's placed on
+     * @note That's the case for patterns without a transform function that either aren't iterable or are static
+     * arrays of such patterns
+     */
+    static bool coversRawData(const ptrn::Pattern *pattern) {
+        if (!pattern->getTransformFunction().empty())
+            return false;
+
+        if (dynamic_cast<const ptrn::Iteratable*>(pattern) == nullptr)
+            return true;
+
+        if (auto array = dynamic_cast<const ptrn::PatternArrayStatic*>(pattern); array != nullptr) {
+            const auto &entryTemplate = array->getTemplate();
+            return !entryTemplate->isPatternLocal() && coversRawData(entryTemplate.get());
+        }
+
+        return false;
+    }
+
+    /**
+     * @brief Feeds the bytes of a pattern to a hash
+     * @note Produces the same bytes as Pattern::getBytes() but reads patterns placed on plain data in chunks instead
+     * of copying all of it first
+     */
+    template<typename Hash>
+    static void processPattern(ptrn::Pattern *pattern, Hash &hash) {
+        if (!coversRawData(pattern)) {
+            hash.process(pattern->getBytes());
+            return;
+        }
+
+        std::vector<u8> buffer;
+        for (u64 offset = 0; offset < pattern->getSize(); offset += ChunkSize) {
+            buffer.resize(std::min<u64>(ChunkSize, pattern->getSize() - offset));
+            pattern->getEvaluator()->readData(pattern->getOffset() + offset, buffer.data(), buffer.size(), pattern->getSection());
+
+            hash.process(buffer);
+        }
+    }
+
+    template<size_t Size>
+    static std::string toHexString(const std::array<u8, Size> &digest) {
+        std::string result;
+        result.reserve(Size * 2);
+        for (const auto byte : digest)
+            result += fmt::format("{:02x}", byte);
+
+        return result;
+    }
+
     void registerFunctions(pl::PatternLanguage &runtime) {
         using FunctionParameterCount = pl::api::FunctionParameterCount;
         using namespace pl::core;
@@ -26,12 +82,78 @@ namespace pl::lib::libstd::hash {
                 auto reflectIn  = params[4].toUnsigned();
                 auto reflectOut = params[5].toUnsigned();
 
-                wolv::hash::Crc<32> crc(poly, init, xorout, reflectIn, reflectOut);
-                crc.process(pattern->getBytes());
+                hlp::Crc<32> crc(poly, init, xorout, reflectIn, reflectOut);
+                processPattern(pattern, crc);
+
+                return u128(crc.getResult());
+            });
+
+            /* crc64(pattern, init, poly, xorout, reflect_in, reflect_out) */
+            runtime.addFunction(nsStdHash, "crc64", FunctionParameterCount::exactly(6), [](Evaluator *ctx, auto params) -> std::optional<Token::Literal> {
+                wolv::util::unused(ctx);
+
+                auto pattern = params[0].toPattern();
+                auto init    = params[1].toUnsigned();
+                auto poly    = params[2].toUnsigned();
+                auto xorout  = params[3].toUnsigned();
+                auto reflectIn  = params[4].toUnsigned();
+                auto reflectOut = params[5].toUnsigned();
+
+                hlp::Crc<64> crc(poly, init, xorout, reflectIn, reflectOut);
+                processPattern(pattern, crc);
 
                 return u128(crc.getResult());
             });
+
+            /* adler32(pattern) */
+            runtime.addFunction(nsStdHash, "adler32", FunctionParameterCount::exactly(1), [](Evaluator *ctx, auto params) -> std::optional<Token::Literal> {
+                wolv::util::unused(ctx);
+
+                auto pattern = params[0].toPattern();
+
+                hlp::Adler32 adler;
+                processPattern(pattern, adler);
+
+                return u128(adler.getResult());
+            });
+
+            /* xxh64(pattern, seed) */
+            runtime.addFunction(nsStdHash, "xxh64", FunctionParameterCount::exactly(2), [](Evaluator *ctx, auto params) -> std::optional<Token::Literal> {
+                wolv::util::unused(ctx);
+
+                auto pattern = params[0].toPattern();
+                auto seed    = params[1].toUnsigned();
+
+                hlp::XxHash64 xxHash(seed);
+                processPattern(pattern, xxHash);
+
+                return u128(xxHash.getResult());
+            });
+
+            /* sha1(pattern) -> hex_digest */
+            runtime.addFunction(nsStdHash, "sha1", FunctionParameterCount::exactly(1), [](Evaluator *ctx, auto params) -> std::optional<Token::Literal> {
+                wolv::util::unused(ctx);
+
+                auto pattern = params[0].toPattern();
+
+                hlp::Sha1 sha1;
+                processPattern(pattern, sha1);
+
+                return toHexString(sha1.getResult());
+            });
+
+            /* sha256(pattern) -> hex_digest */
+            runtime.addFunction(nsStdHash, "sha256", FunctionParameterCount::exactly(1), [](Evaluator *ctx, auto params) -> std::optional<Token::Literal> {
+                wolv::util::unused(ctx);
+
+                auto pattern = params[0].toPattern();
+
+                hlp::Sha256 sha256;
+                processPattern(pattern, sha256);
+
+                return toHexString(sha256.getResult());
+            });
         }
     }
 
-}
\ No newline at end of file
+}
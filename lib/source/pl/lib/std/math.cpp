@@ -8,7 +8,7 @@
 #include <pl/patterns/pattern.hpp>
 #include <pl/lib/std/types.hpp>
 
-#include <pl/helpers/buffered_reader.hpp>
+#include <pl/helpers/utils.hpp>
 
 namespace pl::lib::libstd::math {
 
@@ -17,9 +17,52 @@ namespace pl::lib::libstd::math {
         Multiply 	= 1,
         Modulo 		= 2,
         Min 		= 3,
-        Max 		= 4
+        Max 		= 4,
+        Xor 		= 5,
+        PopCount 	= 6
     };
 
+    constexpr static u64 ChunkSize = 0x10000;
+
+    /**
+     * @brief Reads a range of a section in large chunks
+     * @param chunkSize Size of each chunk. Only the last chunk may be smaller, but never smaller than granularity
+     * @param granularity Bytes at the end of the range that don't fill a whole unit of this size are skipped
+     */
+    template<typename Callback>
+    static void forEachChunk(core::Evaluator *ctx, u64 start, u64 end, u64 section, u64 chunkSize, u64 granularity, Callback &&callback) {
+        std::vector<u8> buffer;
+        for (u64 address = start; address < end && end - address >= granularity;) {
+            const u64 size = std::min<u64>(chunkSize, (end - address) / granularity * granularity);
+
+            buffer.resize(size);
+            ctx->readData(address, buffer.data(), buffer.size(), section);
+            callback(std::span(buffer));
+
+            address += size;
+        }
+    }
+
+    static std::optional<hlp::ReductionOperation> getReductionOperation(AccumulationOperation operation) {
+        switch (operation) {
+            case AccumulationOperation::Add:        return hlp::ReductionOperation::Sum;
+            case AccumulationOperation::Min:        return hlp::ReductionOperation::Minimum;
+            case AccumulationOperation::Max:        return hlp::ReductionOperation::Maximum;
+            case AccumulationOperation::Xor:        return hlp::ReductionOperation::Xor;
+            case AccumulationOperation::PopCount:   return hlp::ReductionOperation::PopCount;
+            default:                                return std::nullopt;
+        }
+    }
+
+    static std::array<u64, 256> getByteHistogram(core::Evaluator *ctx, u64 start, u64 end, u64 section) {
+        std::array<u64, 256> histogram = { };
+        forEachChunk(ctx, start, end, section, ChunkSize, 1, [&](std::span<const u8> chunk) {
+            hlp::addToByteHistogram(chunk, histogram);
+        });
+
+        return histogram;
+    }
+
     void registerFunctions(pl::PatternLanguage &runtime) {
         using FunctionParameterCount = pl::api::FunctionParameterCount;
         using namespace pl::core;
@@ -164,25 +207,23 @@ namespace pl::lib::libstd::math {
                 if (params.size() > 5)
                     endian = static_cast<types::Endian>(params[5].toUnsigned());
 
+                if (size == 0)
+                    err::E0003.throwError("Size cannot be zero", {}, 0);
                 if (size > 16)
                     err::E0003.throwError("Size cannot be bigger than sizeof(u128)", {}, 0);
- 
-                u128 result = 0;
-                u128 endAddr = end / size;
-
-                auto reader = hlp::MemoryReader(ctx, section);
-                reader.seek(start);
-                reader.setEndAddress(end);
-
-                for (u128 addr = start; addr < endAddr; ++addr) {
-                    auto bytes = reader.read(addr, size);
 
-                    // Copy bytes to u128
-                    u128 value = 0;
-                    std::memcpy(&value, bytes.data(), size);
+                // Reductions of values with a power of two size are done a whole chunk at a time using vector instructions
+                const auto reduction = getReductionOperation(op);
+                const bool vectorized = reduction.has_value() && std::has_single_bit(u64(size)) && size <= sizeof(u64);
 
-                    // Swap endianess
-                    value = hlp::changeEndianess(value, size, endian);
+                u128 result = 0;
+                bool empty = true;
+                const auto combine = [&](u128 value) {
+                    if (empty) {
+                        result = value;
+                        empty = false;
+                        return;
+                    }
 
                     // Accumulate value into result
                     switch (op) {
@@ -191,11 +232,84 @@ namespace pl::lib::libstd::math {
                         case AccumulationOperation::Min:        result = std::min(result, value);   break;
                         case AccumulationOperation::Max:        result = std::max(result, value);   break;
                         case AccumulationOperation::Modulo:     result %= value;                    break;
+                        case AccumulationOperation::Xor:        result ^= value;                    break;
+                        case AccumulationOperation::PopCount:   result += value;                    break;
                     }
-                }
+                };
+
+                // Values are read in large chunks and byte swapped all at once instead of one read and swap per value
+                forEachChunk(ctx, start, end, section, ChunkSize / size * size, size, [&](std::span<u8> chunk) {
+                    const u64 count = chunk.size() / size;
+
+                    if (std::endian(endian) != std::endian::native && op != AccumulationOperation::PopCount)
+                        hlp::swapByteOrder(chunk.data(), size, count);
+
+                    if (vectorized) {
+                        combine(hlp::reduce(chunk.data(), size, count, *reduction));
+                        return;
+                    }
+
+                    for (u64 i = 0; i < count; i++) {
+                        // Copy bytes to u128
+                        u128 value = 0;
+                        std::memcpy(&value, chunk.data() + i * size, size);
+
+                        if (op == AccumulationOperation::PopCount)
+                            value = std::popcount(u64(value)) + std::popcount(u64(value >> 64));
+
+                        combine(value);
+                    }
+                });
 
                 return result;
             });
+
+            /* byte_histogram(start, end, section, result_section) -> byte_count */
+            runtime.addFunction(nsStdMath, "byte_histogram", FunctionParameterCount::exactly(4), [](Evaluator *ctx, auto params) -> std::optional<Token::Literal> {
+                auto start          = params[0].toUnsigned();
+                auto end            = params[1].toUnsigned();
+                auto section        = params[2].toUnsigned();
+                auto resultSection  = params[3].toUnsigned();
+
+                if (resultSection == ptrn::Pattern::MainSectionId)
+                    err::E0012.throwError("Cannot write to main section.", "The main section represents the currently loaded data and is immutable.");
+                else if (resultSection == ptrn::Pattern::HeapSectionId)
+                    err::E0012.throwError("Invalid section id.");
+
+                const auto histogram = getByteHistogram(ctx, start, end, section);
+
+                // The histogram is stored as 256 little endian u64, one for each byte value
+                auto &result = ctx->getSection(resultSection);
+                result.resize(histogram.size() * sizeof(u64));
+                for (size_t i = 0; i < histogram.size(); i++) {
+                    const u64 count = hlp::changeEndianess(histogram[i], std::endian::little);
+                    std::memcpy(result.data() + i * sizeof(u64), &count, sizeof(u64));
+                }
+
+                return u128(std::reduce(histogram.begin(), histogram.end(), u64(0)));
+            });
+
+            /* entropy(start, end, section) -> bits_per_byte */
+            runtime.addFunction(nsStdMath, "entropy", FunctionParameterCount::exactly(3), [](Evaluator *ctx, auto params) -> std::optional<Token::Literal> {
+                auto start      = params[0].toUnsigned();
+                auto end        = params[1].toUnsigned();
+                auto section    = params[2].toUnsigned();
+
+                const auto histogram = getByteHistogram(ctx, start, end, section);
+                const auto total = std::reduce(histogram.begin(), histogram.end(), u64(0));
+
+                // Shannon entropy, ranging from 0 for a single repeated byte to 8 for uniformly distributed bytes
+                double entropy = 0;
+                for (const auto count : histogram) {
+                    if (count == 0)
+                        continue;
+
+                    const double probability = double(count) / double(total);
+                    entropy -= probability * std::log2(probability);
+                }
+
+                return entropy;
+            });
         }
     }
 
@@ -5,29 +5,62 @@
 #include <pl/core/evaluator.hpp>
 #include <pl/patterns/pattern.hpp>
 #include <pl/lib/std/types.hpp>
+#include <pl/helpers/signature_scanner.hpp>
 
+#include <algorithm>
+#include <cstring>
+#include <functional>
 #include <vector>
 #include <string>
 
 
 namespace pl::lib::libstd::mem {
 
+    constexpr static u64 SearchChunkSize = 0x100000;
+
     static std::optional<u128> findSequence(core::Evaluator *ctx, u64 occurrenceIndex, u64 offsetFrom, u64 offsetTo, const std::vector<u8> &sequence) {
-        std::vector<u8> bytes(sequence.size(), 0x00);
-        u32 occurrences      = 0;
         const u64 bufferSize = ctx->getDataSize();
         const u64 endOffset  = offsetTo <= offsetFrom ? bufferSize : std::min(bufferSize, u64(offsetTo));
-        for (u64 offset = offsetFrom; offset < endOffset - sequence.size(); offset++) {
-            ctx->readData(offset, bytes.data(), bytes.size(), ptrn::Pattern::MainSectionId);
+        if (offsetFrom >= endOffset || endOffset - offsetFrom < sequence.size())
+            return std::nullopt;
+
+        // An empty sequence matches at every offset
+        if (sequence.empty())
+            return occurrenceIndex < endOffset - offsetFrom ? std::optional<u128>(offsetFrom + occurrenceIndex) : std::nullopt;
+
+        // Long sequences are skipped through with Boyer-Moore-Horspool, single bytes are found with memchr
+        const std::boyer_moore_horspool_searcher searcher(sequence.begin(), sequence.end());
+        const auto findNext = [&](const u8 *begin, const u8 *end) -> const u8* {
+            if (sequence.size() == 1) {
+                auto result = static_cast<const u8*>(std::memchr(begin, sequence.front(), end - begin));
+                return result == nullptr ? end : result;
+            } else {
+                return std::search(begin, end, searcher);
+            }
+        };
+
+        // Each chunk overlaps the next one by one byte less than the sequence so matches crossing the boundary are
+        // found exactly once, in the chunk they start in
+        std::vector<u8> bytes;
+        u64 occurrences = 0;
+        for (u64 chunkOffset = offsetFrom; endOffset - chunkOffset >= sequence.size(); chunkOffset += SearchChunkSize) {
+            const auto readSize = std::min<u64>(SearchChunkSize + sequence.size() - 1, endOffset - chunkOffset);
 
-            if (bytes == sequence) {
+            bytes.resize(readSize);
+            ctx->readData(chunkOffset, bytes.data(), readSize, ptrn::Pattern::MainSectionId);
+
+            const auto chunkEnd = bytes.data() + bytes.size();
+            for (auto match = findNext(bytes.data(), chunkEnd); match != chunkEnd; match = findNext(match + 1, chunkEnd)) {
                 if (occurrences < occurrenceIndex) {
                     occurrences++;
                     continue;
                 }
 
-                return u128(offset);
+                return u128(chunkOffset + (match - bytes.data()));
             }
+
+            if (endOffset - chunkOffset <= SearchChunkSize)
+                break;
         }
 
         return std::nullopt;
@@ -83,6 +116,54 @@ namespace pl::lib::libstd::mem {
                 return findSequence(ctx, occurrenceIndex, offsetFrom, offsetTo, std::vector<u8>(string.data(), string.data() + string.size())).value_or(-1);
             });
 
+            /* find_signatures_in_range(section_id, start_offset, end_offset, signatures...) -> hit_count */
+            runtime.addFunction(nsStdMem, "find_signatures_in_range", FunctionParameterCount::moreThan(3), [](Evaluator *ctx, auto params) -> std::optional<Token::Literal> {
+                auto sectionId  = params[0].toUnsigned();
+                auto offsetFrom = params[1].toUnsigned();
+                auto offsetTo   = params[2].toUnsigned();
+
+                if (sectionId == ptrn::Pattern::MainSectionId)
+                    err::E0012.throwError("Cannot write to main section.", "The main section represents the currently loaded data and is immutable.");
+                else if (sectionId == ptrn::Pattern::HeapSectionId)
+                    err::E0012.throwError("Invalid section id.");
+
+                std::vector<std::string> signatures;
+                for (u32 i = 3; i < params.size(); i++)
+                    signatures.push_back(params[i].toString(false));
+
+                // All signatures are searched for in a single pass over the range
+                hlp::SignatureScanner scanner(signatures);
+                std::vector<hlp::SignatureScanner::Hit> hits;
+
+                const u64 bufferSize = ctx->getDataSize();
+                const u64 endOffset  = offsetTo <= offsetFrom ? bufferSize : std::min(bufferSize, u64(offsetTo));
+
+                std::vector<u8> bytes;
+                for (u64 chunkOffset = offsetFrom; chunkOffset < endOffset; chunkOffset += SearchChunkSize) {
+                    bytes.resize(std::min<u64>(SearchChunkSize, endOffset - chunkOffset));
+                    ctx->readData(chunkOffset, bytes.data(), bytes.size(), ptrn::Pattern::MainSectionId);
+
+                    scanner.scan(chunkOffset, bytes, hits);
+                }
+
+                std::sort(hits.begin(), hits.end(), [](const auto &left, const auto &right) {
+                    return left.address != right.address ? left.address < right.address : left.signature < right.signature;
+                });
+
+                // Hits are stored as pairs of little endian u64 holding the start address and the index of the signature
+                auto &section = ctx->getSection(sectionId);
+                section.resize(hits.size() * sizeof(u64) * 2);
+                for (u64 i = 0; i < hits.size(); i++) {
+                    const u64 address   = hlp::changeEndianess(hits[i].address, std::endian::little);
+                    const u64 signature = hlp::changeEndianess(u64(hits[i].signature), std::endian::little);
+
+                    std::memcpy(section.data() + i * sizeof(u64) * 2, &address, sizeof(u64));
+                    std::memcpy(section.data() + i * sizeof(u64) * 2 + sizeof(u64), &signature, sizeof(u64));
+                }
+
+                return u128(hits.size());
+            });
+
             /* read_unsigned(address, size, endian) */
             runtime.addFunction(nsStdMem, "read_unsigned", FunctionParameterCount::exactly(3), [](Evaluator *ctx, auto params) -> std::optional<Token::Literal> {
                 auto address            = params[0].toUnsigned();
@@ -7,11 +7,18 @@
 #include <pl/core/evaluator.hpp>
 #include <pl/core/errors/error.hpp>
 
+#include <pl/patterns/pattern.hpp>
+#include <pl/patterns/pattern_array_static.hpp>
+
+#include <pl/helpers/parallel.hpp>
+
 #include <pl/lib/std/libstd.hpp>
 
 #include <wolv/io/fs.hpp>
 #include <wolv/io/file.hpp>
 
+#include <span>
+
 namespace pl {
 
     PatternLanguage::PatternLanguage(bool addLibStd) {
@@ -26,6 +33,8 @@ namespace pl {
     }
 
     PatternLanguage::~PatternLanguage() {
+        this->joinFlattenThread();
+
         this->m_patterns.clear();
         this->m_flattenedPatterns.clear();
         this->m_currAST.clear();
@@ -38,6 +47,8 @@ namespace pl {
     }
 
     PatternLanguage::PatternLanguage(PatternLanguage &&other) noexcept {
+        other.joinFlattenThread();
+
         this->m_internals           = other.m_internals;
         other.m_internals = { };
 
@@ -45,7 +56,11 @@ namespace pl {
         this->m_currAST             = std::move(other.m_currAST);
 
         this->m_patterns            = std::move(other.m_patterns);
-        this->m_flattenedPatterns   = other.m_flattenedPatterns;
+        this->m_flattenedPatterns   = std::move(other.m_flattenedPatterns);
+        this->m_flattened           = other.m_flattened.load();
+        this->m_addressIndexMode    = other.m_addressIndexMode;
+        this->m_appendMode          = other.m_appendMode;
+        this->m_lastExecution       = std::move(other.m_lastExecution);
 
         this->m_running             = other.m_running;
     }
@@ -90,6 +105,9 @@ namespace pl {
 
         auto &evaluator = this->m_internals.evaluator;
 
+        // The index of the last run may still be built in the background. Let it see an abort before clearing it
+        this->joinFlattenThread();
+
         this->m_running = true;
         this->m_aborted = false;
         ON_SCOPE_EXIT { this->m_running = false; };
@@ -105,26 +123,37 @@ namespace pl {
                 cleanupCallback(*this);
         };
 
-        this->reset();
+        // In append mode, running the same code again on data that only grew continues the last evaluation from its checkpoint
+        ExecutionInputs inputs = { code, envVars, inVariables, checkResult };
+        const bool resume = this->m_appendMode && this->m_lastExecution == inputs && evaluator->canResumeEvaluation();
+        this->m_lastExecution.reset();
+
+        if (resume)
+            this->clearResults();
+        else
+            this->reset();
+
         evaluator->setInVariables(inVariables);
 
         for (const auto &[name, value] : envVars)
             evaluator->setEnvVariable(name, value);
 
-        this->m_currAST.clear();
-
-        {
-            auto ast = this->parseString(code);
-            if (!ast)
-                return false;
+        if (!resume) {
+            this->m_currAST.clear();
 
-            this->m_currAST = std::move(ast.value());
-        }
+            {
+                auto ast = this->parseString(code);
+                if (!ast)
+                    return false;
 
-        evaluator->dataOffset() = this->m_startAddress.value_or(evaluator->getDataBaseAddress());
+                this->m_currAST = std::move(ast.value());
+            }
 
+            evaluator->dataOffset() = this->m_startAddress.value_or(evaluator->getDataBaseAddress());
+        }
 
-        if (!evaluator->evaluate(code, this->m_currAST)) {
+        const bool succeeded = resume ? evaluator->resumeEvaluation(code) : evaluator->evaluate(code, this->m_currAST);
+        if (!succeeded) {
             this->m_currError = evaluator->getConsole().getLastHardError();
             return false;
         }
@@ -142,7 +171,21 @@ namespace pl {
             this->m_patterns[pattern->getSection()].push_back(pattern);
         this->m_patterns.erase(ptrn::Pattern::HeapSectionId);
 
-        this->flattenPatterns();
+        switch (this->m_addressIndexMode) {
+            case AddressIndexMode::Eager:
+                wolv::util::unused(this->getFlattenedPatterns());
+                break;
+            case AddressIndexMode::Lazy:
+                break;
+            case AddressIndexMode::Background:
+                // Flattening never modifies a pattern, so the patterns can be handed out while this thread is still running
+                this->m_flattenThread = std::thread([this] {
+                    wolv::util::unused(this->getFlattenedPatterns());
+                });
+                break;
+        }
+
+        this->m_lastExecution = std::move(inputs);
 
         if (this->m_aborted) {
             this->reset();
@@ -169,6 +212,28 @@ namespace pl {
         return { success, std::move(result) };
     }
 
+    bool PatternLanguage::notifyDataModified(u64 address, size_t size) {
+        if (!this->m_lastExecution.has_value())
+            return false;
+
+        if (this->m_internals.evaluator->isLayoutDependentOn(address, size)) {
+            auto inputs = std::move(*this->m_lastExecution);
+            this->m_lastExecution.reset();
+
+            return this->executeString(std::move(inputs.code), inputs.envVars, inputs.inVariables, inputs.checkResult);
+        }
+
+        if (size == 0)
+            return true;
+
+        // The layout stays the same, only the values of the patterns covering the modified bytes need to be formatted again
+        const auto &flattenedPatterns = this->getFlattenedPatterns();
+        if (flattenedPatterns.contains(ptrn::Pattern::MainSectionId))
+            clearFormatCaches(flattenedPatterns.at(ptrn::Pattern::MainSectionId), address, address + size - 1);
+
+        return true;
+    }
+
     void PatternLanguage::abort() {
         this->m_internals.evaluator->abort();
         this->m_aborted = true;
@@ -194,6 +259,15 @@ namespace pl {
         this->m_internals.evaluator->setDataSource(baseAddress, size, std::move(readFunction), std::move(writeFunction));
     }
 
+    void PatternLanguage::setAppendMode(bool enabled) {
+        this->m_appendMode = enabled;
+        this->m_internals.evaluator->setAppendMode(enabled);
+    }
+
+    void PatternLanguage::setStreamDataSource(std::function<size_t(u8*, size_t)> readFunction, size_t windowSize) const {
+        this->m_internals.evaluator->setStreamDataSource(std::make_shared<hlp::StreamWindow>(std::move(readFunction), windowSize));
+    }
+
     void PatternLanguage::setDataBaseAddress(u64 baseAddress) const {
         this->m_internals.evaluator->setDataBaseAddress(baseAddress);
     }
@@ -210,10 +284,18 @@ namespace pl {
         this->m_startAddress = address;
     }
 
+    void PatternLanguage::setAddressIndexMode(AddressIndexMode mode) {
+        this->m_addressIndexMode = mode;
+    }
+
     void PatternLanguage::setDangerousFunctionCallHandler(std::function<bool()> callback) const {
         this->m_internals.evaluator->setDangerousFunctionCallHandler(std::move(callback));
     }
 
+    void PatternLanguage::setPatternSink(api::PatternSink sink, bool includeArrayEntries) const {
+        this->m_internals.evaluator->setPatternSink(std::move(sink), includeArrayEntries);
+    }
+
     const std::vector<std::shared_ptr<core::ast::ASTNode>> &PatternLanguage::getCurrentAST() const {
         return this->m_currAST;
     }
@@ -264,16 +346,26 @@ namespace pl {
     }
 
 
-    void PatternLanguage::reset() {
+    void PatternLanguage::clearResults() {
+        this->joinFlattenThread();
+
         this->m_patterns.clear();
         this->m_flattenedPatterns.clear();
+        this->m_flattened = false;
+
+        this->m_currError.reset();
+        this->m_internals.evaluator->getConsole().clear();
+    }
+
+    void PatternLanguage::reset() {
+        this->clearResults();
+
+        this->m_internals.evaluator->releasePatterns();
 
         this->m_currAST.clear();
+        this->m_lastExecution.reset();
 
-        this->m_currError.reset();
         this->m_internals.validator->setRecursionDepth(32);
-
-        this->m_internals.evaluator->getConsole().clear();
         this->m_internals.evaluator->setDefaultEndian(this->m_defaultEndian);
         this->m_internals.evaluator->setBitfieldOrder({});
         this->m_internals.evaluator->setEvaluationDepth(32);
@@ -304,47 +396,253 @@ namespace pl {
         this->m_internals.evaluator->addBuiltinFunction(getFunctionName(ns, name), parameterCount, { }, func, true);
     }
 
-    void PatternLanguage::flattenPatterns() {
-        using Interval = interval_tree::Interval<u64, ptrn::Pattern*>;
+    const std::map<u64, PatternLanguage::FlattenedPatterns> &PatternLanguage::getFlattenedPatterns() const {
+        if (!this->m_flattened) {
+            std::scoped_lock lock(this->m_flattenMutex);
+
+            if (!this->m_flattened) {
+                this->flattenPatterns();
+
+                // An aborted build is left empty and tried again by the next lookup
+                if (!this->m_aborted)
+                    this->m_flattened = true;
+            }
+        }
+
+        return this->m_flattenedPatterns;
+    }
 
+    void PatternLanguage::joinFlattenThread() {
+        if (this->m_flattenThread.joinable())
+            this->m_flattenThread.join();
+    }
+
+    void PatternLanguage::flattenPatterns() const {
+        // Top-level patterns are flattened in chunks on all threads. Each chunk collects its own intervals
+        constexpr static size_t ChunkSize = 64;
+
+        // Flattening only reads the patterns. Anything allocated along the way still belongs to the evaluation
+        hlp::Arena::Scope arenaScope(this->m_internals.evaluator->getPatternArena());
+
+        struct Chunk {
+            size_t sectionIndex;
+            std::span<const std::shared_ptr<ptrn::Pattern>> patterns;
+            std::vector<FlattenedPatterns::Interval> intervals;
+        };
+
+        std::vector<u64> sections;
+        std::vector<Chunk> chunks;
         for (const auto &[section, patterns] : this->m_patterns) {
-            std::vector<Interval> intervals;
+            for (size_t i = 0; i < patterns.size(); i += ChunkSize)
+                chunks.push_back({ sections.size(), std::span(patterns).subspan(i, std::min(ChunkSize, patterns.size() - i)), { } });
+
+            sections.push_back(section);
+        }
+
+        hlp::parallelFor(chunks.size(), [&](size_t index) {
+            auto &[sectionIndex, patterns, intervals] = chunks[index];
             for (const auto &pattern : patterns) {
-                auto children = pattern->getChildren();
+                if (!this->flattenChildren(pattern->getIndexChildren(), intervals))
+                    return;
+            }
+        });
 
-                intervals.reserve(children.size());
-                for (const auto &[address, child]: children) {
-                    if (this->m_aborted)
-                        return;
+        if (this->m_aborted)
+            return;
+
+        // Merge the chunks in order so patterns starting at the same address keep their order
+        std::vector<std::vector<FlattenedPatterns::Interval>> sectionIntervals(sections.size());
+        for (auto &[sectionIndex, patterns, intervals] : chunks) {
+            auto &merged = sectionIntervals[sectionIndex];
+            if (merged.empty())
+                merged = std::move(intervals);
+            else
+                std::move(intervals.begin(), intervals.end(), std::back_inserter(merged));
+        }
 
-                    if (child->getSize() == 0)
-                        continue;
+        std::vector<FlattenedPatterns> indices(sections.size());
+        hlp::parallelFor(sections.size(), [&](size_t index) {
+            indices[index] = FlattenedPatterns(std::move(sectionIntervals[index]));
+        });
 
-                    intervals.emplace_back(address, address + child->getSize() - 1, child);
-                }
+        for (size_t i = 0; i < sections.size(); i++)
+            this->m_flattenedPatterns[sections[i]] = std::move(indices[i]);
+    }
+
+    bool PatternLanguage::flattenChildren(const std::vector<std::pair<u64, ptrn::Pattern*>> &children, std::vector<FlattenedPatterns::Interval> &intervals) const {
+        intervals.reserve(intervals.size() + children.size());
+        for (const auto &[address, child] : children) {
+            if (this->m_aborted)
+                return false;
+
+            if (child->getSize() == 0)
+                continue;
+
+            auto array = dynamic_cast<ptrn::PatternArrayStatic*>(child);
+            if (array == nullptr || array->isSealed()) {
+                intervals.push_back({ address, address + child->getSize() - 1, FlattenedPattern { child, nullptr } });
+                continue;
             }
 
-            this->m_flattenedPatterns[section] = std::move(intervals);
+            // Only flatten the first entry of static arrays. All other entries are found using the array stride
+            std::vector<FlattenedPatterns::Interval> entryIntervals;
+            if (!this->flattenChildren(array->getHighlightTemplate()->getIndexChildren(), entryIntervals))
+                return false;
+
+            const auto stride = array->getTemplate()->getSize();
+            const bool entryContained = std::all_of(entryIntervals.begin(), entryIntervals.end(), [&](const auto &interval) {
+                return interval.start >= address && interval.end < address + stride;
+            });
+
+            if (entryContained) {
+                intervals.push_back({ address, address + stride * array->getEntryCount() - 1, FlattenedPattern { child, std::make_shared<FlattenedArray>(FlattenedArray { stride, FlattenedPatterns(std::move(entryIntervals)) }) } });
+            } else {
+                // Entries reach outside of their own bounds (e.g. through pointers), repeat them for every entry instead
+                for (u64 i = 0; i < array->getEntryCount(); i++) {
+                    for (const auto &interval : entryIntervals) {
+                        if (this->m_aborted)
+                            return false;
+
+                        intervals.push_back({ interval.start + i * stride, interval.end + i * stride, interval.value });
+                    }
+                }
+            }
         }
+
+        return true;
+    }
+
+    void PatternLanguage::findFlattenedPatterns(const FlattenedPatterns &patterns, u64 start, u64 end, u64 shift, std::vector<FoundPattern> &results) {
+        patterns.findOverlapping(start, end, [&](u64 intervalStart, u64 intervalEnd, const FlattenedPattern &flattenedPattern) {
+            const auto &[pattern, array] = flattenedPattern;
+
+            if (array == nullptr) {
+                results.push_back({ intervalStart + shift, intervalEnd + shift, pattern });
+            } else {
+                // Search the entries overlapping the range, relative to the first entry of the array
+                const auto stride     = array->stride;
+                const auto firstEntry = start > intervalStart ? (start - intervalStart) / stride : 0;
+                const auto lastEntry  = (std::min(end, intervalEnd) - intervalStart) / stride;
+
+                for (u64 entry = firstEntry; entry <= lastEntry; entry++) {
+                    const auto entryShift = entry * stride;
+                    const auto entryStart = std::max(start, intervalStart + entryShift);
+                    const auto entryEnd   = std::min(end, intervalStart + entryShift + stride - 1);
+
+                    findFlattenedPatterns(array->entryPatterns, entryStart - entryShift, entryEnd - entryShift, shift + entryShift, results);
+                }
+            }
+        });
+    }
+
+    void PatternLanguage::clearFormatCaches(const FlattenedPatterns &patterns, u64 start, u64 end) {
+        patterns.findOverlapping(start, end, [&](u64 intervalStart, u64 intervalEnd, const FlattenedPattern &flattenedPattern) {
+            const auto &[pattern, array] = flattenedPattern;
+
+            if (array == nullptr) {
+                pattern->clearFormatCache();
+            } else {
+                // Static arrays cache the formatted values of their entries by index
+                const auto firstEntry = start > intervalStart ? (start - intervalStart) / array->stride : 0;
+                const auto lastEntry  = (std::min(end, intervalEnd) - intervalStart) / array->stride;
+                static_cast<ptrn::PatternArrayStatic*>(pattern)->clearFormatCache(firstEntry, lastEntry + 1);
+
+                // All entries are formatted using the patterns of the first one
+                clearFormatCaches(array->entryPatterns, intervalStart, intervalStart + array->stride - 1);
+            }
+        });
     }
 
     std::vector<ptrn::Pattern *> PatternLanguage::getPatternsAtAddress(u64 address, u64 section) const {
-        if (this->m_flattenedPatterns.empty() || !this->m_flattenedPatterns.contains(section))
+        const auto &flattenedPatterns = this->getFlattenedPatterns();
+        if (flattenedPatterns.empty() || !flattenedPatterns.contains(section))
             return { };
 
-        auto intervals = this->m_flattenedPatterns.at(section).findOverlapping(address, address);
+        std::vector<FoundPattern> foundPatterns;
+        findFlattenedPatterns(flattenedPatterns.at(section), address, address, 0, foundPatterns);
 
         std::vector<ptrn::Pattern*> results;
-        std::transform(intervals.begin(), intervals.end(), std::back_inserter(results), [](const auto &interval) {
-            ptrn::Pattern* value = interval.value;
+        results.reserve(foundPatterns.size());
+        for (const auto &[start, end, pattern] : foundPatterns) {
+            pattern->setOffset(start);
+            pattern->clearFormatCache();
+
+            results.push_back(pattern);
+        }
+
+        return results;
+    }
+
+    std::vector<PatternLanguage::PatternSpan::Entry> PatternLanguage::findPatternsAtAddress(u64 address, u64 section) const {
+        auto spans = this->getPatternsInRange(address, address, section);
+        if (spans.empty())
+            return { };
+
+        return std::move(spans.front().patterns);
+    }
+
+    std::vector<PatternLanguage::PatternSpan> PatternLanguage::getPatternsInRange(u64 start, u64 end, u64 section) const {
+        if (start > end)
+            return { };
+
+        const auto &flattenedPatterns = this->getFlattenedPatterns();
+        if (!flattenedPatterns.contains(section))
+            return { };
 
-            value->setOffset(interval.start);
-            value->clearFormatCache();
+        std::vector<FoundPattern> foundPatterns;
+        findFlattenedPatterns(flattenedPatterns.at(section), start, end, 0, foundPatterns);
 
-            return value;
+        std::stable_sort(foundPatterns.begin(), foundPatterns.end(), [](const FoundPattern &left, const FoundPattern &right) {
+            return left.start < right.start;
         });
 
-        return results;
+        std::vector<PatternSpan::Entry> entries;
+        entries.reserve(foundPatterns.size());
+
+        // Sweep over the points where patterns begin or end within the range
+        std::vector<std::pair<u64, i64>> events;
+        events.reserve(foundPatterns.size() * 2);
+        for (const auto &[patternStart, patternEnd, pattern] : foundPatterns) {
+            const auto index = i64(entries.size());
+            entries.push_back({ pattern, patternStart, pattern->getColor(), pattern->getVisibility() });
+
+            events.emplace_back(std::max(patternStart, start), index + 1);
+            if (patternEnd < end)
+                events.emplace_back(patternEnd + 1, -(index + 1));
+        }
+
+        std::sort(events.begin(), events.end(), [](const auto &left, const auto &right) {
+            return left.first < right.first;
+        });
+
+        std::vector<PatternSpan> result;
+        std::vector<i64> active;
+        for (size_t i = 0; i < events.size();) {
+            const auto position = events[i].first;
+
+            for (; i < events.size() && events[i].first == position; i++) {
+                const auto [eventPosition, event] = events[i];
+                const auto index = std::abs(event) - 1;
+                const auto iter  = std::lower_bound(active.begin(), active.end(), index);
+
+                if (event > 0)
+                    active.insert(iter, index);
+                else
+                    active.erase(iter);
+            }
+
+            if (active.empty())
+                continue;
+
+            const auto spanEnd = i < events.size() ? events[i].first - 1 : end;
+
+            auto &span = result.emplace_back(PatternSpan { position, spanEnd, { } });
+            span.patterns.reserve(active.size());
+            for (const auto index : active)
+                span.patterns.push_back(entries[index]);
+        }
+
+        return result;
     }
 
 }
\ No newline at end of file
@@ -1,10 +1,17 @@
 #pragma once
 
+#include <algorithm>
+#include <functional>
+#include <span>
 #include <string>
 #include <vector>
 
+#include <pl/pattern_language.hpp>
+#include <pl/core/errors/evaluator_errors.hpp>
 #include <pl/patterns/pattern.hpp>
 
+#include <fmt/format.h>
+
 #define TEST(name) (pl::test::TestPattern *)new pl::test::TestPattern##name()
 
 namespace pl::test {
@@ -55,6 +62,64 @@ namespace pl::test {
             return true;
         }
 
+        [[nodiscard]] virtual bool runRuntimeChecks(PatternLanguage &runtime) const {
+            wolv::util::unused(runtime);
+
+            return true;
+        }
+
+        /**
+         * @brief Registers the functions available to the source code of tests, such as std::assert
+         * @param runtime Runtime to register the functions on
+         */
+        static void addTestFunctions(PatternLanguage &runtime) {
+            runtime.addFunction({ "std" }, "assert", api::FunctionParameterCount::exactly(2), [](core::Evaluator *ctx, auto params) -> std::optional<core::Token::Literal> {
+                wolv::util::unused(ctx);
+
+                auto condition = params[0].toBoolean();
+                auto message   = params[1].toString(false);
+
+                if (!condition)
+                    core::err::E0012.throwError(fmt::format("assertion failed \"{0}\"", message));
+
+                return std::nullopt;
+            });
+        }
+
+        /**
+         * @brief Runs code on a separate runtime with its own data source
+         * @param setDataSource Function setting up the data source of the runtime
+         * @param sourceCode Code to run, which can use the same functions as the source code of the tests
+         * @param expectedError If not empty, the code is expected to fail with an error message containing this text
+         * @return True if the code succeeded or failed as expected
+         */
+        [[nodiscard]] static bool executeOnDataSource(const std::function<void(PatternLanguage&)> &setDataSource, const std::string &sourceCode, const std::string &expectedError = "") {
+            PatternLanguage runtime;
+            setDataSource(runtime);
+            addTestFunctions(runtime);
+
+            const bool result = runtime.executeString(sourceCode);
+
+            if (expectedError.empty())
+                return result;
+            else
+                return !result && runtime.getError().has_value() && runtime.getError()->message.contains(expectedError);
+        }
+
+        /**
+         * @brief Runs code on a separate runtime reading from a buffer
+         * @param data Data the code runs on
+         * @param sourceCode Code to run, which can use the same functions as the source code of the tests
+         * @return True if the code succeeded
+         */
+        [[nodiscard]] static bool executeOnData(std::span<const u8> data, const std::string &sourceCode) {
+            return executeOnDataSource([data](PatternLanguage &runtime) {
+                runtime.setDataSource(0x00, data.size(), [data](u64 address, u8 *buffer, u64 size) {
+                    std::copy_n(data.begin() + address, size, buffer);
+                });
+            }, sourceCode);
+        }
+
     private:
         std::vector<std::unique_ptr<ptrn::Pattern>> m_patterns;
         Mode m_mode;
@@ -0,0 +1,115 @@
+#pragma once
+
+#include "test_pattern.hpp"
+
+#include <pl/core/evaluator.hpp>
+
+#include <atomic>
+#include <set>
+#include <thread>
+#include <tuple>
+#include <vector>
+
+namespace pl::test {
+
+    class TestPatternAddressIndexModes : public TestPattern {
+    public:
+        TestPatternAddressIndexModes() : TestPattern("AddressIndexModes") {
+
+        }
+        ~TestPatternAddressIndexModes() override = default;
+
+        [[nodiscard]] std::string getSourceCode() const override {
+            return R"(
+                struct Entry {
+                    u16 value;
+                    u8 flags;
+                };
+
+                struct Chunk {
+                    be u32 length;
+                    char type[4];
+                };
+
+                Chunk header @ 0x08;
+                Entry entries[0x2000] @ 0x100;
+                Entry dynamicEntries[while($ < 0x10000)] @ 0x8000;
+                u32 words[0x1000] @ 0x10000;
+                u32 overlapping @ 0x10002;
+            )";
+        }
+
+        // The test runtime builds its index eagerly, the other modes need to end up with the same results
+        [[nodiscard]] bool runRuntimeChecks(PatternLanguage &runtime) const override {
+            auto evaluator = runtime.getInternals().evaluator;
+
+            std::vector<u8> data(evaluator->getDataSize());
+            evaluator->readData(0x00, data.data(), data.size(), ptrn::Pattern::MainSectionId);
+
+            const auto expected = findAll(runtime);
+            if (std::get<0>(expected).empty())
+                return false;
+
+            for (const auto mode : { PatternLanguage::AddressIndexMode::Lazy, PatternLanguage::AddressIndexMode::Background }) {
+                PatternLanguage modeRuntime;
+                modeRuntime.setDataSource(0x00, data.size(), [&data](u64 address, u8 *buffer, u64 size) {
+                    std::copy_n(data.begin() + address, size, buffer);
+                });
+                modeRuntime.setAddressIndexMode(mode);
+
+                // Running the code again while the last index may still be getting built
+                for (u32 run = 0; run < 2; run++) {
+                    if (!modeRuntime.executeString(this->getSourceCode()))
+                        return false;
+
+                    // Queries start right away, before the index is done
+                    std::atomic<bool> valid = true;
+                    std::vector<std::jthread> threads;
+                    for (u32 i = 0; i < 4; i++) {
+                        threads.emplace_back([&] {
+                            if (findAll(modeRuntime) != expected)
+                                valid = false;
+                        });
+                    }
+                    threads.clear();
+
+                    if (!valid)
+                        return false;
+                }
+
+                // An abort must only stop the index being built, the next run needs to build it again
+                if (!modeRuntime.executeString(this->getSourceCode()))
+                    return false;
+                modeRuntime.abort();
+
+                if (!modeRuntime.executeString(this->getSourceCode()) || findAll(modeRuntime) != expected)
+                    return false;
+            }
+
+            return true;
+        }
+
+    private:
+        using Names = std::set<std::pair<std::string, u64>>;
+        using Spans = std::vector<std::tuple<u64, u64, Names>>;
+
+        [[nodiscard]] static std::tuple<std::vector<Names>, Spans> findAll(PatternLanguage &runtime) {
+            std::vector<Names> addresses;
+            for (const u64 address : { 0x00, 0x08, 0x0C, 0x100, 0x102, 0x100 + 0x1FFF * 3, 0x8000, 0x8000 + 0x1234 * 3 + 1, 0x10002, 0x10004, 0x13FFF, 0x14000 }) {
+                auto &names = addresses.emplace_back();
+                for (const auto &entry : runtime.findPatternsAtAddress(address))
+                    names.emplace(entry.pattern->getVariableName(), entry.offset);
+            }
+
+            Spans spans;
+            for (const auto &span : runtime.getPatternsInRange(0xFFF0, 0x10010)) {
+                auto &[start, end, names] = spans.emplace_back(span.start, span.end, Names { });
+                for (const auto &entry : span.patterns)
+                    names.emplace(entry.pattern->getVariableName(), entry.offset);
+            }
+
+            return { addresses, spans };
+        }
+    };
+
+}
@@ -0,0 +1,106 @@
+#pragma once
+
+#include "test_pattern.hpp"
+
+#include <pl/core/evaluator.hpp>
+#include <pl/formatters/formatter_json.hpp>
+
+#include <algorithm>
+#include <map>
+#include <string>
+#include <tuple>
+#include <vector>
+
+namespace pl::test {
+
+    class TestPatternAppendMode : public TestPattern {
+    public:
+        TestPatternAppendMode() : TestPattern("AppendMode") {
+
+        }
+        ~TestPatternAppendMode() override = default;
+
+        // PNG chunks with side effects in the array entries, in the code before the array and in main
+        [[nodiscard]] std::string getSourceCode() const override {
+            return R"(
+                struct Chunk {
+                    be u32 length;
+                    char type[4];
+                    u8 data[length];
+                    be u32 crc;
+
+                    builtin::std::print("chunk {}", type);
+                };
+
+                u8 signature[8] @ 0x00;
+                builtin::std::print("signature {}", signature[1]);
+                builtin::std::print("width {}", builtin::std::mem::read_unsigned(0x10, 3, 1));
+
+                Chunk chunks[while($ < builtin::std::mem::size())] @ 0x08;
+
+                fn main() {
+                    u128 section = builtin::std::mem::create_section("summary");
+                    builtin::std::mem::copy_value_to_section(builtin::std::format("{}", builtin::std::core::member_count(chunks)), section, 0x00);
+
+                    builtin::std::print("{} chunks", builtin::std::core::member_count(chunks));
+                };
+            )";
+        }
+
+        [[nodiscard]] bool runRuntimeChecks(PatternLanguage &runtime) const override {
+            auto evaluator = runtime.getInternals().evaluator;
+
+            std::vector<u8> data(evaluator->getDataSize());
+            evaluator->readData(0x00, data.data(), data.size(), ptrn::Pattern::MainSectionId);
+
+            std::vector<u64> chunkStarts;
+            for (u64 offset = 0x08; offset + 4 <= data.size(); offset += u64(data[offset] << 24 | data[offset + 1] << 16 | data[offset + 2] << 8 | data[offset + 3]) + 12)
+                chunkStarts.push_back(offset);
+
+            // The data gets cut off in the middle of a chunk twice before all of it is available
+            const auto fullRun = run(data, { data.size() });
+            const auto appendedRun = run(data, { chunkStarts[3] + 2, chunkStarts[10] + 0x100, data.size() });
+
+            // The first run leaves out the chunk cut off at the end and says so
+            const auto firstRun = run(data, { chunkStarts[3] + 2 });
+            const bool dropNoted = std::ranges::any_of(std::get<2>(firstRun), [&](const auto &entry) {
+                return entry.second.contains(fmt::format("0x{:X}", chunkStarts[3]));
+            });
+
+            return chunkStarts.size() > 10 && dropNoted && std::get<3>(appendedRun) == 1 && std::get<0>(fullRun) == std::get<0>(appendedRun) &&
+                   std::get<1>(fullRun) == std::get<1>(appendedRun) && std::get<2>(fullRun) == std::get<2>(appendedRun);
+        }
+
+    private:
+        using Sections = std::map<u64, std::pair<std::string, std::vector<u8>>>;
+        using Log = std::vector<std::pair<core::LogConsole::Level, std::string>>;
+
+        // Runs the code in append mode once for each data size and returns the results of the last run together with the
+        // number of evaluations that ran the code in front of the array, going by the width reads it does
+        [[nodiscard]] std::tuple<std::vector<u8>, Sections, Log, u32> run(const std::vector<u8> &data, const std::vector<u64> &sizes) const {
+            PatternLanguage appendRuntime;
+            appendRuntime.setAppendMode(true);
+            addTestFunctions(appendRuntime);
+
+            u32 fullEvaluations = 0;
+            for (const auto size : sizes) {
+                appendRuntime.setDataSource(0x00, size, [&data, &fullEvaluations](u64 address, u8 *buffer, u64 size) {
+                    if (address == 0x10 && size == 3)
+                        fullEvaluations++;
+
+                    std::copy_n(data.begin() + address, size, buffer);
+                });
+
+                if (!appendRuntime.executeString(this->getSourceCode()))
+                    return { };
+            }
+
+            Sections sections;
+            for (const auto &[id, section] : appendRuntime.getSections())
+                sections[id] = { section.name, section.data };
+
+            return { gen::fmt::FormatterJson().format(appendRuntime), sections, appendRuntime.getConsoleLog(), fullEvaluations };
+        }
+    };
+
+}
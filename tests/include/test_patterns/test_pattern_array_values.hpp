@@ -0,0 +1,273 @@
+#pragma once
+
+#include "test_pattern.hpp"
+
+#include <pl/core/evaluator.hpp>
+#include <pl/patterns/pattern_array_dynamic.hpp>
+#include <pl/patterns/pattern_array_static.hpp>
+#include <pl/patterns/pattern_float.hpp>
+#include <pl/patterns/pattern_signed.hpp>
+#include <pl/patterns/pattern_unsigned.hpp>
+
+#include <algorithm>
+#include <bit>
+#include <cstring>
+#include <memory>
+#include <optional>
+#include <span>
+#include <vector>
+
+namespace pl::test {
+
+    class TestPatternArrayValues : public TestPattern {
+    public:
+        TestPatternArrayValues() : TestPattern("ArrayValues") {
+
+        }
+        ~TestPatternArrayValues() override = default;
+
+        [[nodiscard]] std::string getSourceCode() const override {
+            return R"(
+                enum Tag : u32 {
+                    Header = 0x49484452
+                };
+
+                be u32 beWords[0x41] @ 0x100;
+                le u32 leWords[0x41] @ 0x100;
+                be s16 beShorts[0x83] @ 0x200;
+                le s16 leShorts[0x83] @ 0x200;
+                be float beFloats[0x21] @ 0x400;
+                le float leFloats[0x21] @ 0x400;
+                be double beDoubles[0x11] @ 0x500;
+                le double leDoubles[0x11] @ 0x500;
+
+                Tag tags[while($ < 0x700)] @ 0x600;
+            )";
+        }
+
+        [[nodiscard]] bool runRuntimeChecks(PatternLanguage &runtime) const override {
+            auto evaluator = runtime.getInternals().evaluator;
+
+            std::vector<u8> data(evaluator->getDataSize());
+            evaluator->readData(0x00, data.data(), data.size(), ptrn::Pattern::MainSectionId);
+
+            return checkStaticArrays(runtime, data) && checkDynamicArray(runtime, data) &&
+                   checkHalfFloats(evaluator, data) && checkDynamicLayouts(evaluator, data);
+        }
+
+    private:
+        // Values as they'd be read one at a time, straight from the raw bytes
+        template<typename T>
+        [[nodiscard]] static std::vector<T> expectedValues(const std::vector<u8> &data, u64 address, u64 count, std::endian endian) {
+            using Bits = std::conditional_t<sizeof(T) == 2, u16, std::conditional_t<sizeof(T) == 4, u32, u64>>;
+
+            std::vector<T> result;
+            for (u64 i = 0; i < count; i++) {
+                Bits bits = 0;
+                std::memcpy(&bits, data.data() + address + i * sizeof(T), sizeof(T));
+                if (endian != std::endian::native)
+                    bits = std::byteswap(bits);
+
+                result.push_back(std::bit_cast<T>(bits));
+            }
+
+            return result;
+        }
+
+        [[nodiscard]] static ptrn::Pattern *findPattern(PatternLanguage &runtime, const std::string &name) {
+            for (const auto &pattern : runtime.getAllPatterns()) {
+                if (pattern->getVariableName() == name)
+                    return pattern.get();
+            }
+
+            return nullptr;
+        }
+
+        // Reads all entries and the entries past a non-zero start and compares them bit by bit
+        template<typename T, typename Array>
+        [[nodiscard]] static bool checkValues(const Array &array, const std::vector<u8> &data, u64 start, std::endian endian) {
+            const auto count = array.getEntryCount() - start;
+
+            std::vector<T> values(count);
+            if (!array.readValues(start, std::span(values)))
+                return false;
+
+            const auto expected = expectedValues<T>(data, array.getOffset() + start * sizeof(T), count, endian);
+
+            return std::memcmp(values.data(), expected.data(), count * sizeof(T)) == 0;
+        }
+
+        // Ranges past the end are refused without touching the buffer, empty ranges up to the end are fine
+        template<typename T, typename Array>
+        [[nodiscard]] static bool checkBounds(const Array &array) {
+            const auto count = array.getEntryCount();
+
+            std::vector<T> values(count, T(0x55));
+            if (array.readValues(1, std::span(values)) || array.readValues(count + 1, std::span(values).first(0)))
+                return false;
+            if (!array.readValues(count, std::span(values).first(0)))
+                return false;
+
+            return std::ranges::all_of(values, [](T value) { return value == T(0x55); });
+        }
+
+        template<typename T>
+        [[nodiscard]] static bool checkStaticArray(PatternLanguage &runtime, const std::vector<u8> &data, const std::string &name, std::endian endian) {
+            auto array = dynamic_cast<ptrn::PatternArrayStatic*>(findPattern(runtime, name));
+            if (array == nullptr)
+                return false;
+
+            return checkValues<T>(*array, data, 0, endian) && checkValues<T>(*array, data, 3, endian) && checkBounds<T>(*array);
+        }
+
+        [[nodiscard]] static bool checkStaticArrays(PatternLanguage &runtime, const std::vector<u8> &data) {
+            if (!checkStaticArray<u32>(runtime, data, "beWords", std::endian::big) || !checkStaticArray<u32>(runtime, data, "leWords", std::endian::little))
+                return false;
+            if (!checkStaticArray<i16>(runtime, data, "beShorts", std::endian::big) || !checkStaticArray<i16>(runtime, data, "leShorts", std::endian::little))
+                return false;
+            if (!checkStaticArray<float>(runtime, data, "beFloats", std::endian::big) || !checkStaticArray<float>(runtime, data, "leFloats", std::endian::little))
+                return false;
+            if (!checkStaticArray<double>(runtime, data, "beDoubles", std::endian::big) || !checkStaticArray<double>(runtime, data, "leDoubles", std::endian::little))
+                return false;
+
+            // Entries need to be exactly as big as T and of a matching kind
+            auto words = dynamic_cast<ptrn::PatternArrayStatic*>(findPattern(runtime, "beWords"));
+            auto floats = dynamic_cast<ptrn::PatternArrayStatic*>(findPattern(runtime, "beFloats"));
+            std::vector<u16> shorts(4);
+            std::vector<float> wordFloats(4);
+            std::vector<u32> floatWords(4);
+
+            return !words->readValues(0, std::span(shorts)) && !words->readValues(0, std::span(wordFloats)) && !floats->readValues(0, std::span(floatWords));
+        }
+
+        // Enum arrays are dynamic, their entries are still read as integers
+        [[nodiscard]] static bool checkDynamicArray(PatternLanguage &runtime, const std::vector<u8> &data) {
+            auto array = dynamic_cast<ptrn::PatternArrayDynamic*>(findPattern(runtime, "tags"));
+            if (array == nullptr || array->getEntryCount() != 0x40)
+                return false;
+
+            return checkValues<u32>(*array, data, 0, std::endian::little) && checkValues<u32>(*array, data, 5, std::endian::little) && checkBounds<u32>(*array);
+        }
+
+        // Half precision floats don't exist in the language, so the array is put together by hand
+        [[nodiscard]] static bool checkHalfFloats(core::Evaluator *evaluator, const std::vector<u8> &data) {
+            constexpr static u64 Address = 0x800, Count = 0x403;
+
+            for (const auto endian : { std::endian::big, std::endian::little }) {
+                auto entry = std::make_unique<ptrn::PatternFloat>(evaluator, Address, sizeof(u16));
+                entry->setEndian(endian);
+
+                ptrn::PatternArrayStatic array(evaluator, Address, Count * sizeof(u16));
+                array.setEntries(std::move(entry), Count);
+
+                for (const u64 start : { 0, 7 }) {
+                    std::vector<float> values(Count - start);
+                    if (!array.readValues(start, std::span(values)))
+                        return false;
+
+                    const auto halfs = expectedValues<u16>(data, Address + start * sizeof(u16), Count - start, endian);
+                    for (u64 i = 0; i < values.size(); i++) {
+                        if (std::bit_cast<u32>(values[i]) != std::bit_cast<u32>(hlp::float16ToFloat32(halfs[i])))
+                            return false;
+                    }
+                }
+
+                // Half floats can only be read as float
+                std::vector<u16> raw(Count);
+                std::vector<double> doubles(Count);
+                if (array.readValues(0, std::span(raw)) || array.readValues(0, std::span(doubles)))
+                    return false;
+            }
+
+            return true;
+        }
+
+        template<typename T = ptrn::PatternUnsigned>
+        [[nodiscard]] static std::shared_ptr<ptrn::Pattern> createEntry(core::Evaluator *evaluator, u64 offset, size_t size = sizeof(u32), std::endian endian = std::endian::little) {
+            auto entry = std::make_shared<T>(evaluator, offset, size);
+            entry->setEndian(endian);
+
+            return entry;
+        }
+
+        // Dynamic arrays can only be read at once if all entries are the same and sit right next to each other
+        [[nodiscard]] static bool checkDynamicLayouts(core::Evaluator *evaluator, const std::vector<u8> &data) {
+            constexpr static u64 Address = 0x600;
+
+            // Returns the values read, or nothing if the array refused and left the buffer alone
+            const auto readsAs = [&](std::vector<std::shared_ptr<ptrn::Pattern>> entries, u64 start = 0) -> std::optional<std::vector<u32>> {
+                ptrn::PatternArrayDynamic array(evaluator, Address, 0);
+                array.setEntries(std::move(entries));
+
+                std::vector<u32> values(array.getEntryCount() - start, 0x55);
+                if (array.readValues(start, std::span(values)))
+                    return values;
+
+                // A refusal that still wrote to the buffer shows up as an empty result that matches nothing
+                if (!std::ranges::all_of(values, [](u32 value) { return value == 0x55; }))
+                    return std::vector<u32> { };
+
+                return std::nullopt;
+            };
+
+            const auto contiguous = [&](std::endian endian = std::endian::little) {
+                std::vector<std::shared_ptr<ptrn::Pattern>> entries;
+                for (u64 i = 0; i < 8; i++)
+                    entries.push_back(createEntry(evaluator, Address + i * sizeof(u32), sizeof(u32), endian));
+
+                return entries;
+            };
+
+            // Back to back entries read fine, also when the range starts past a differing entry
+            if (readsAs(contiguous(std::endian::big)) != expectedValues<u32>(data, Address, 8, std::endian::big))
+                return false;
+
+            auto entries = contiguous();
+            if (readsAs(entries) != expectedValues<u32>(data, Address, 8, std::endian::little))
+                return false;
+
+            entries[0] = createEntry<ptrn::PatternSigned>(evaluator, Address);
+            if (readsAs(entries) || readsAs(entries, 1) != expectedValues<u32>(data, Address + sizeof(u32), 7, std::endian::little))
+                return false;
+
+            // Mixed types
+            entries = contiguous();
+            entries[5] = createEntry<ptrn::PatternSigned>(evaluator, Address + 5 * sizeof(u32));
+            if (readsAs(entries))
+                return false;
+
+            // A gap between entries
+            entries = contiguous();
+            entries[5] = createEntry(evaluator, Address + 5 * sizeof(u32) + 1);
+            if (readsAs(entries))
+                return false;
+
+            // A different size
+            entries = contiguous();
+            entries[5] = createEntry(evaluator, Address + 5 * sizeof(u32), sizeof(u16));
+            if (readsAs(entries))
+                return false;
+
+            // A different endianness
+            entries = contiguous();
+            entries[5]->setEndian(std::endian::big);
+            if (readsAs(entries))
+                return false;
+
+            // A different section
+            entries = contiguous();
+            entries[5]->setSection(1);
+            if (readsAs(entries))
+                return false;
+
+            // A transform function
+            entries = contiguous();
+            entries[5]->setTransformFunction("transform");
+            if (readsAs(entries))
+                return false;
+
+            return true;
+        }
+    };
+
+}
@@ -0,0 +1,168 @@
+#pragma once
+
+#include "test_pattern.hpp"
+
+#include <pl/formatters/formatter_binary.hpp>
+#include <pl/formatters/binary_reader.hpp>
+
+namespace pl::test {
+
+    class TestPatternBinaryResults : public TestPattern {
+    public:
+        TestPatternBinaryResults() : TestPattern("BinaryResults") {
+
+        }
+        ~TestPatternBinaryResults() override = default;
+
+        [[nodiscard]] std::string getSourceCode() const override {
+            return R"(
+                enum Kind : u8 {
+                    Png = 0x89,
+                    Other = 0x00
+                };
+
+                struct Inner {
+                    char letters[3];
+                    u8 newline;
+                } [[comment("Signature text")]];
+
+                struct Header {
+                    Kind kind;
+                    Inner inner;
+                    be u16 lineEnd;
+                    bool flag;      // Placed on 0x0A, which is neither 0 nor 1
+                };
+
+                Header header @ 0x00;
+                u8 *pointer : u8 @ 0x0C;
+                s8 negative @ 0x1D;
+                u8 bytes[4] @ 0x08;
+                bool cleared @ 0x08;
+            )";
+        }
+
+        [[nodiscard]] bool runRuntimeChecks(PatternLanguage &runtime) const override {
+            return checkResults(runtime, true) && checkResults(runtime, false);
+        }
+
+    private:
+        using Reader    = gen::fmt::BinaryResultReader;
+        using Tag       = gen::fmt::bin::Tag;
+
+        // Counts the nodes while skipping over the entries of all objects
+        class CountingVisitor : public Reader::Visitor {
+        public:
+            bool enter(const Reader::Node &node) override {
+                this->count += 1;
+
+                return node.tag != Tag::Object;
+            }
+
+            void leave(const Reader::Node &node) override {
+                this->left += 1;
+                this->leftObject = this->leftObject || node.tag == Tag::Object;
+            }
+
+            u32 count = 0, left = 0;
+            bool leftObject = false;
+        };
+
+        [[nodiscard]] static bool checkResults(PatternLanguage &runtime, bool metaInformation) {
+            gen::fmt::FormatterBinary formatter;
+            formatter.enableMetaInformation(metaInformation);
+            const auto data = formatter.format(runtime);
+
+            const Reader reader(data);
+            if (reader.hasMetaInformation() != metaInformation)
+                return false;
+
+            // header, pointer, its pointed at pattern, negative, bytes and its four entries and cleared. Only the pointer and bytes are left again
+            CountingVisitor counter;
+            reader.visit(counter);
+            if (counter.count != 10 || counter.left != 2 || counter.leftObject)
+                return false;
+
+            const auto tree = reader.readTree();
+            if (tree.size() != 5)
+                return false;
+
+            const auto &header = tree[0];
+            if (!hasNode(header, Tag::Object, "header", 4) || !hasMeta(header.node, metaInformation, "Header", 0x00, 8))
+                return false;
+
+            const auto &kind = header.entries[0];
+            if (!hasNode(kind, Tag::Enum, "kind", 0) || kind.node.value != decltype(kind.node.value)(u128(0x89)) || !kind.node.valueName.contains("Png"))
+                return false;
+
+            const auto &inner = header.entries[1];
+            if (!hasNode(inner, Tag::Object, "inner", 2) || !hasMeta(inner.node, metaInformation, "Inner", 0x01, 4))
+                return false;
+            if ((inner.node.comment == "Signature text") != metaInformation)
+                return false;
+
+            // Character arrays are exported as strings
+            const auto &letters = inner.entries[0];
+            if (!hasNode(letters, Tag::String, "letters", 0) || letters.node.value != decltype(letters.node.value)(std::string_view("PNG")))
+                return false;
+
+            const auto &lineEnd = header.entries[2];
+            if (!hasNode(lineEnd, Tag::Unsigned, "lineEnd", 0) || lineEnd.node.value != decltype(lineEnd.node.value)(u128(0x0A1A)))
+                return false;
+            if (metaInformation && lineEnd.node.endian != std::endian::big)
+                return false;
+
+            // Booleans stored as other bytes than 0 and 1 are displayed as "true*" but exported as a plain true
+            const auto &flag = header.entries[3];
+            if (!hasNode(flag, Tag::Boolean, "flag", 0) || flag.node.value != decltype(flag.node.value)(true))
+                return false;
+            if (!hasFormattedFlag(runtime, "true*"))
+                return false;
+
+            const auto &pointer = tree[1];
+            if (!hasNode(pointer, Tag::Pointer, "pointer", 1) || pointer.node.value != decltype(pointer.node.value)(u128(0x49)))
+                return false;
+
+            const auto &pointedAt = pointer.entries[0];
+            if (!hasNode(pointedAt, Tag::Unsigned, "*(pointer)", 0) || pointedAt.node.value != decltype(pointedAt.node.value)(u128(0x6D)))
+                return false;
+            if (!hasMeta(pointedAt.node, metaInformation, "u8", 0x49, 1))
+                return false;
+
+            const auto &negative = tree[2];
+            if (!hasNode(negative, Tag::Signed, "negative", 0) || negative.node.value != decltype(negative.node.value)(i128(-26)))
+                return false;
+
+            // Array entries don't have names
+            const auto &bytes = tree[3];
+            if (!hasNode(bytes, Tag::Array, "bytes", 4) || !std::ranges::all_of(bytes.entries, [](const auto &entry) { return entry.node.name.empty(); }))
+                return false;
+            if (bytes.entries[3].node.value != decltype(bytes.entries[3].node.value)(u128(0x0D)) || !hasMeta(bytes.entries[3].node, metaInformation, "u8", 0x0B, 1))
+                return false;
+
+            const auto &cleared = tree[4];
+            if (!hasNode(cleared, Tag::Boolean, "cleared", 0) || cleared.node.value != decltype(cleared.node.value)(false))
+                return false;
+
+            return true;
+        }
+
+        [[nodiscard]] static bool hasFormattedFlag(PatternLanguage &runtime, std::string_view value) {
+            const auto &header = runtime.getAllPatterns().front();
+            const auto flag = dynamic_cast<ptrn::Iteratable*>(header.get())->getEntry(3);
+
+            return flag->getVariableName() == "flag" && flag->getFormattedValue() == value;
+        }
+
+        [[nodiscard]] static bool hasNode(const Reader::TreeNode &node, Tag tag, std::string_view name, size_t entryCount) {
+            return node.node.tag == tag && node.node.name == name && node.entries.size() == entryCount;
+        }
+
+        [[nodiscard]] static bool hasMeta(const Reader::Node &node, bool metaInformation, std::string_view typeName, u64 offset, u64 size) {
+            if (!metaInformation)
+                return node.typeName.empty() && node.offset == 0 && node.size == 0;
+
+            return node.typeName == typeName && node.offset == offset && node.size == size;
+        }
+    };
+
+}
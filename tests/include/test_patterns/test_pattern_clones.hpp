@@ -0,0 +1,126 @@
+#pragma once
+
+#include "test_pattern.hpp"
+
+#include <pl/patterns/pattern_struct.hpp>
+#include <pl/patterns/pattern_union.hpp>
+#include <pl/patterns/pattern_array_dynamic.hpp>
+#include <pl/patterns/pattern_array_static.hpp>
+
+#include <algorithm>
+
+namespace pl::test {
+
+    class TestPatternClones : public TestPattern {
+    public:
+        TestPatternClones() : TestPattern("Clones") {
+
+        }
+        ~TestPatternClones() override = default;
+
+        [[nodiscard]] std::string getSourceCode() const override {
+            return R"(
+                union Value {
+                    u16 word;
+                    u8 bytes[2];
+                };
+
+                struct Inner {
+                    u8 a;
+                    Value value;
+                };
+
+                struct Outer {
+                    Inner inner;
+                    u8 values[while($ < 0x08)];
+                };
+
+                Outer outer @ 0x00;
+            )";
+        }
+
+        [[nodiscard]] bool runRuntimeChecks(PatternLanguage &runtime) const override {
+            const auto &patterns = runtime.getAllPatterns();
+            if (patterns.size() != 1 || !hasPatternsWithColor(runtime, 0x00))
+                return false;
+
+            auto &original = *patterns.front();
+            {
+                auto clone = original.clone();
+                if (!isOwned(original, *clone))
+                    return false;
+
+                // Modifying the original must neither move its children out from under the address index nor change the clone
+                original.setColor(Color);
+                if (hasPatternsWithColor(*clone, Color))
+                    return false;
+            }
+
+            for (const u64 address : { 0x00, 0x01, 0x02, 0x05 }) {
+                if (!hasPatternsWithColor(runtime, address))
+                    return false;
+            }
+
+            return true;
+        }
+
+    private:
+        constexpr static u32 Color = 0x12345678;
+
+        // Patterns found in the address index need to be the original's current children
+        [[nodiscard]] static bool hasPatternsWithColor(PatternLanguage &runtime, u64 address) {
+            const auto entries = runtime.findPatternsAtAddress(address);
+            if (entries.empty())
+                return false;
+
+            const auto color = runtime.getAllPatterns().front()->getColor();
+            return std::all_of(entries.begin(), entries.end(), [color](const auto &entry) {
+                return entry.pattern->getColor() == color;
+            });
+        }
+
+        [[nodiscard]] static bool hasPatternsWithColor(ptrn::Pattern &pattern, u32 color) {
+            const auto children = pattern.getChildren();
+
+            return std::any_of(children.begin(), children.end(), [color](const auto &child) {
+                return child.second->getColor() == color;
+            });
+        }
+
+        // Clones need their own copies of all children, which are equal to the original's
+        [[nodiscard]] static bool isOwned(ptrn::Pattern &original, ptrn::Pattern &clone) {
+            if (original != clone)
+                return false;
+
+            auto originalIteratable = dynamic_cast<ptrn::Iteratable*>(&original);
+            auto cloneIteratable    = dynamic_cast<ptrn::Iteratable*>(&clone);
+            if (originalIteratable == nullptr || cloneIteratable == nullptr)
+                return true;
+
+            if (dynamic_cast<ptrn::PatternArrayStatic*>(&original) != nullptr)
+                return true;
+
+            std::vector<ptrn::Pattern*> visited;
+            cloneIteratable->forEachEntry(0, cloneIteratable->getEntryCount(), [&](u64, ptrn::Pattern *entry) {
+                visited.push_back(entry);
+            });
+
+            const auto originalEntries = originalIteratable->getEntries();
+            const auto cloneEntries    = cloneIteratable->getEntries();
+            if (originalEntries.size() != cloneEntries.size() || visited.size() != cloneEntries.size())
+                return false;
+
+            for (size_t i = 0; i < cloneEntries.size(); i++) {
+                if (cloneEntries[i] == originalEntries[i] || cloneIteratable->getEntry(i) != cloneEntries[i])
+                    return false;
+                if (std::find(visited.begin(), visited.end(), cloneEntries[i].get()) == visited.end())
+                    return false;
+                if (!isOwned(*originalEntries[i], *cloneEntries[i]))
+                    return false;
+            }
+
+            return true;
+        }
+    };
+
+}
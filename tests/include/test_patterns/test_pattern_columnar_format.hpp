@@ -0,0 +1,266 @@
+#pragma once
+
+#include "test_pattern.hpp"
+
+#include <pl/core/evaluator.hpp>
+#include <pl/formatters/formatter_columnar.hpp>
+
+#include <bit>
+#include <cmath>
+#include <optional>
+#include <string>
+#include <vector>
+
+namespace pl::test {
+
+    class TestPatternColumnarFormat : public TestPattern {
+    public:
+        TestPatternColumnarFormat() : TestPattern("ColumnarFormat") {
+
+        }
+        ~TestPatternColumnarFormat() override = default;
+
+        [[nodiscard]] std::string getSourceCode() const override {
+            return R"(
+                enum Kind : u8 {
+                    First,
+                    Second
+                };
+
+                struct StaticEntry {
+                    u16 value;
+                    be s24 small;
+                    double ratio;
+                } [[static]];
+
+                struct Entry {
+                    u16 value;
+                    be s32 delta;
+                    s24 small;
+                    be float ratio;
+                    char letter;
+                    Kind kind;
+                    be s48 large;
+                };
+
+                struct Mixed {
+                    u8 kind;
+                    if (kind & 1)
+                        u16 value;
+                    else
+                        s16 value;
+                };
+
+                StaticEntry statics[0x31] @ 0x100;
+                be u16 words[0x81] @ 0x400;
+                Entry entries[0x40] @ 0x800;
+                Mixed mixed[0x20] @ 0x1000;
+            )";
+        }
+
+        [[nodiscard]] bool runRuntimeChecks(PatternLanguage &runtime) const override {
+            auto evaluator = runtime.getInternals().evaluator;
+
+            std::vector<u8> data(evaluator->getDataSize());
+            evaluator->readData(0x00, data.data(), data.size(), ptrn::Pattern::MainSectionId);
+
+            if (!checkTables(runtime, { { "statics", 0x31 }, { "words", 0x81 }, { "entries", 0x40 } }))
+                return false;
+
+            // Keeping only every other entry leaves gaps between them, so each row gets read from its own address
+            PatternLanguage sinkRuntime;
+            sinkRuntime.setDataSource(0x00, data.size(), [&data](u64 address, u8 *buffer, u64 size) {
+                std::copy_n(data.begin() + address, size, buffer);
+            });
+
+            u32 entryCount = 0;
+            sinkRuntime.setPatternSink([&](const std::shared_ptr<ptrn::Pattern> &pattern) {
+                if (!pattern->getVariableName().starts_with('[') || pattern->getOffset() < 0x800 || pattern->getOffset() >= 0x1000)
+                    return true;
+
+                return entryCount++ % 2 == 0;
+            }, true);
+
+            if (!sinkRuntime.executeString(this->getSourceCode()))
+                return false;
+
+            return checkTables(sinkRuntime, { { "statics", 0x31 }, { "words", 0x81 }, { "entries", 0x20 } });
+        }
+
+    private:
+        struct Column {
+            std::string name;
+            gen::fmt::col::ColumnType type;
+            u8 width;
+            u64 offset;
+        };
+
+        struct Table {
+            std::string name;
+            u64 rowCount;
+            std::vector<Column> columns;
+        };
+
+        struct Value {
+            std::string name;
+            core::Token::Literal value;
+            size_t size;
+        };
+
+        struct Reader {
+            const std::vector<u8> &data;
+            u64 position = 0;
+            bool valid = true;
+
+            u64 read(size_t size) {
+                if (position + size > data.size()) {
+                    valid = false;
+                    return 0;
+                }
+
+                u64 value = 0;
+                for (size_t i = 0; i < size; i++)
+                    value |= u64(data[position + i]) << (i * 8);
+                position += size;
+
+                return value;
+            }
+
+            std::string readString(size_t size) {
+                if (position + size > data.size()) {
+                    valid = false;
+                    return { };
+                }
+
+                std::string value(data.begin() + position, data.begin() + position + size);
+                position += size;
+
+                return value;
+            }
+        };
+
+        // Parses the schema, making sure the column data follows it directly, aligned to 8 bytes and without overlapping
+        [[nodiscard]] static std::optional<std::vector<Table>> parseSchema(const std::vector<u8> &output) {
+            Reader reader = { output };
+            if (reader.readString(4) != std::string("PLC\0", 4) || reader.read(4) != gen::fmt::col::Version)
+                return std::nullopt;
+
+            std::vector<Table> tables(reader.read(4));
+            if (reader.read(4) != 0)
+                return std::nullopt;
+
+            for (auto &table : tables) {
+                table.rowCount = reader.read(8);
+                table.columns.resize(reader.read(4));
+                table.name = reader.readString(reader.read(4));
+
+                for (auto &column : table.columns) {
+                    column.offset = reader.read(8);
+                    column.type   = gen::fmt::col::ColumnType(reader.read(1));
+                    column.width  = u8(reader.read(1));
+                    if (reader.read(2) != 0)
+                        return std::nullopt;
+                    column.name   = reader.readString(reader.read(4));
+                }
+            }
+
+            u64 end = reader.position;
+            for (const auto &table : tables) {
+                for (const auto &column : table.columns) {
+                    if (column.offset != (end + 7) / 8 * 8)
+                        return std::nullopt;
+
+                    end = column.offset + table.rowCount * column.width;
+                }
+            }
+
+            if (!reader.valid || end != output.size())
+                return std::nullopt;
+
+            return tables;
+        }
+
+        // Values of all fields of an entry in the order the columns are written, as the patterns themselves report them
+        static void collectValues(ptrn::Pattern *pattern, std::vector<Value> &values, const std::string &prefix) {
+            if (auto structPattern = dynamic_cast<ptrn::PatternStruct*>(pattern); structPattern != nullptr) {
+                structPattern->forEachEntry(0, structPattern->getEntryCount(), [&](u64, ptrn::Pattern *member) {
+                    collectValues(member, values, prefix + member->getVariableName() + ".");
+                });
+            } else {
+                values.push_back({ prefix.empty() ? "value" : prefix.substr(0, prefix.size() - 1), pattern->getValue(), pattern->getSize() });
+            }
+        }
+
+        [[nodiscard]] static bool checkValue(const std::vector<u8> &output, const Column &column, u64 row, const core::Token::Literal &expected) {
+            u64 value = 0;
+            for (u8 i = 0; i < column.width; i++)
+                value |= u64(output[column.offset + row * column.width + i]) << (i * 8);
+
+            const auto mask = column.width == sizeof(u64) ? ~u64(0) : (u64(1) << (column.width * 8)) - 1;
+            switch (column.type) {
+                using enum gen::fmt::col::ColumnType;
+
+                case Float: {
+                    const auto number = expected.toFloatingPoint();
+                    const auto actual = column.width == sizeof(float) ? double(std::bit_cast<float>(u32(value))) : std::bit_cast<double>(value);
+
+                    return std::isnan(number) ? std::isnan(actual) : actual == number;
+                }
+                case Signed:
+                    // Sign extended to the full width of the column
+                    return value == (u64(i64(expected.toSigned())) & mask);
+                default:
+                    return value == (u64(expected.toUnsigned()) & mask);
+            }
+        }
+
+        [[nodiscard]] static bool checkTables(PatternLanguage &runtime, const std::vector<std::pair<std::string, u64>> &expectedTables) {
+            const auto output = gen::fmt::FormatterColumnar().format(runtime);
+
+            const auto tables = parseSchema(output);
+            if (!tables.has_value() || tables->size() != expectedTables.size())
+                return false;
+
+            for (u64 tableIndex = 0; tableIndex < tables->size(); tableIndex++) {
+                const auto &table = (*tables)[tableIndex];
+                if (table.name != expectedTables[tableIndex].first || table.rowCount != expectedTables[tableIndex].second)
+                    return false;
+
+                ptrn::Iteratable *array = nullptr;
+                for (const auto &pattern : runtime.getAllPatterns()) {
+                    if (pattern->getVariableName() == table.name)
+                        array = dynamic_cast<ptrn::Iteratable*>(pattern.get());
+                }
+
+                if (array == nullptr || array->getEntryCount() != table.rowCount)
+                    return false;
+
+                bool valid = true;
+                array->forEachEntry(0, array->getEntryCount(), [&](u64 row, ptrn::Pattern *entry) {
+                    std::vector<Value> values;
+                    collectValues(entry, values, "");
+
+                    if (values.size() != table.columns.size()) {
+                        valid = false;
+                        return;
+                    }
+
+                    // Values are stored in the smallest power of two they fit in
+                    for (u64 i = 0; i < values.size(); i++) {
+                        const auto &[name, value, size] = values[i];
+                        const auto &column = table.columns[i];
+
+                        if (name != column.name || column.width != std::bit_ceil(size) || !checkValue(output, column, row, value))
+                            valid = false;
+                    }
+                });
+
+                if (!valid)
+                    return false;
+            }
+
+            return true;
+        }
+    };
+
+}
@@ -0,0 +1,135 @@
+#pragma once
+
+#include "test_pattern.hpp"
+
+#include <pl/patterns/pattern_array_dynamic.hpp>
+
+#include <atomic>
+#include <thread>
+#include <vector>
+
+namespace pl::test {
+
+    class TestPatternConcurrentQueries : public TestPattern {
+    public:
+        TestPatternConcurrentQueries() : TestPattern("ConcurrentQueries") {
+
+        }
+        ~TestPatternConcurrentQueries() override = default;
+
+        [[nodiscard]] std::string getSourceCode() const override {
+            return R"(
+                struct Entry {
+                    u8 value;
+                } [[format("format_entry")]];
+
+                fn format_entry(Entry entry) {
+                    return builtin::std::core::array_index();
+                };
+
+                Entry entries[32] @ 0x00;
+                Entry single @ 0x40;
+
+                fn format_hex(u16 value) {
+                    return builtin::std::format("{:X} @ {:X}", value, $);
+                };
+
+                using Hex = u16 [[format("format_hex")]];
+
+                u16 words[8] @ 0x80;
+                s8 bytes[8] @ 0x90;
+                float floats[4] @ 0xA0;
+                bool flags[8] @ 0xB0;
+                char chars[8] @ 0xB8;
+                Hex hexes[4] @ 0xC0;
+            )";
+        }
+
+        [[nodiscard]] bool runRuntimeChecks(PatternLanguage &runtime) const override {
+            PatternLanguage otherRuntime;
+            otherRuntime.setDataSource(0x00, 0x100, [](u64, u8 *buffer, u64 size) {
+                std::fill_n(buffer, size, 0x00);
+            });
+
+            if (!otherRuntime.executeString(this->getSourceCode()))
+                return false;
+
+            auto [entries, single] = findPatterns(runtime);
+            auto [otherEntries, otherSingle] = findPatterns(otherRuntime);
+            if (entries == nullptr || single == nullptr || otherEntries == nullptr || otherSingle == nullptr)
+                return false;
+
+            // Iterating over an array of one evaluator must not leak its index into the patterns of another one
+            bool valid = true;
+            entries->forEachEntry(0, entries->getEntryCount(), [&](u64 index, ptrn::Pattern *entry) {
+                valid = valid && hasIndex(*entry, index) && hasIndex(*otherSingle, 0);
+            });
+
+            // Every thread tracks its own index while iterating over the same arrays
+            std::atomic<bool> threadsValid = true;
+            std::vector<std::jthread> threads;
+            for (u32 i = 0; i < 8; i++) {
+                threads.emplace_back([&, array = (i % 2 == 0) ? entries : otherEntries, other = (i % 2 == 0) ? otherSingle : single] {
+                    for (u32 iteration = 0; iteration < 16; iteration++) {
+                        array->forEachEntry(0, array->getEntryCount(), [&](u64 index, ptrn::Pattern *entry) {
+                            if (!hasIndex(*entry, index) || !hasIndex(*other, 0))
+                                threadsValid = false;
+                        });
+                    }
+                });
+            }
+            threads.clear();
+
+            // Leaf entries of static arrays are formatted in place at the queried offset, from all threads at once
+            for (u32 i = 0; i < 8; i++) {
+                threads.emplace_back([&] {
+                    if (!checkLeafOffsets(runtime))
+                        threadsValid = false;
+                });
+            }
+            threads.clear();
+
+            return valid && threadsValid;
+        }
+
+    private:
+        // Formatting a pattern at an offset has to give the same result as formatting a copy of it placed there
+        [[nodiscard]] static bool checkLeafOffsets(PatternLanguage &runtime) {
+            u32 movedEntries = 0;
+            for (u64 address = 0x80; address < 0xC8; address++) {
+                for (const auto &entry : runtime.findPatternsAtAddress(address)) {
+                    if (entry.offset == entry.pattern->getOffset())
+                        continue;
+
+                    auto copy = entry.pattern->clone();
+                    copy->setOffset(entry.offset);
+
+                    if (entry.pattern->getFormattedValueAt(entry.offset) != copy->getFormattedValue())
+                        return false;
+
+                    movedEntries += 1;
+                }
+            }
+
+            return movedEntries > 0;
+        }
+
+        [[nodiscard]] static bool hasIndex(ptrn::Pattern &pattern, u64 index) {
+            return pattern.getFormattedValueAt(pattern.getOffset()) == std::to_string(index);
+        }
+
+        [[nodiscard]] static std::pair<ptrn::PatternArrayDynamic*, ptrn::Pattern*> findPatterns(PatternLanguage &runtime) {
+            std::pair<ptrn::PatternArrayDynamic*, ptrn::Pattern*> result = { };
+
+            for (const auto &pattern : runtime.getAllPatterns()) {
+                if (pattern->getVariableName() == "entries")
+                    result.first = dynamic_cast<ptrn::PatternArrayDynamic*>(pattern.get());
+                else if (pattern->getVariableName() == "single")
+                    result.second = pattern.get();
+            }
+
+            return result;
+        }
+    };
+
+}
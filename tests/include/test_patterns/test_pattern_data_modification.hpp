@@ -0,0 +1,98 @@
+#pragma once
+
+#include "test_pattern.hpp"
+
+#include <pl/core/evaluator.hpp>
+#include <pl/patterns/pattern_array_static.hpp>
+
+#include <array>
+
+namespace pl::test {
+
+    class TestPatternDataModification : public TestPattern {
+    public:
+        TestPatternDataModification() : TestPattern("DataModification") {
+
+        }
+        ~TestPatternDataModification() override = default;
+
+        [[nodiscard]] std::string getSourceCode() const override {
+            return R"(
+                struct Pair {
+                    u8 first;
+                    u8 second;
+                } [[static]];
+
+                u8 bytes[8] @ 0x00;
+                Pair pairs[4] @ 0x08;
+                u32 value @ 0x10;
+            )";
+        }
+
+        [[nodiscard]] bool runRuntimeChecks(PatternLanguage &runtime) const override {
+            // Format everything once so all caches are filled
+            const auto oldValues = readValues(runtime);
+            if (!oldValues.has_value())
+                return false;
+
+            std::array<u8, 1> byte = { 0xAB };
+            std::array<u8, 1> second = { 0xCD };
+            std::array<u8, 4> value = { 0x78, 0x56, 0x34, 0x12 };
+            if (!modifyData(runtime, 0x02, byte) || !modifyData(runtime, 0x0B, second) || !modifyData(runtime, 0x10, value))
+                return false;
+
+            const auto newValues = readValues(runtime);
+            if (!newValues.has_value())
+                return false;
+
+            const auto &[oldByte, oldUnchangedByte, oldSecond, oldValue] = *oldValues;
+            const auto &[newByte, newUnchangedByte, newSecond, newValue] = *newValues;
+
+            return newByte != oldByte && newByte.contains("171") &&
+                   newUnchangedByte == oldUnchangedByte &&
+                   newSecond != oldSecond && newSecond.contains("205") &&
+                   newValue != oldValue && newValue.contains("305419896");
+        }
+
+    private:
+        [[nodiscard]] static bool modifyData(PatternLanguage &runtime, u64 address, std::span<u8> data) {
+            runtime.getInternals().evaluator->writeData(address, data.data(), data.size(), ptrn::Pattern::MainSectionId);
+
+            return runtime.notifyDataModified(address, data.size());
+        }
+
+        [[nodiscard]] static std::optional<std::array<std::string, 4>> readValues(PatternLanguage &runtime) {
+            std::array<std::string, 4> result;
+            std::array<bool, 3> found = { };
+
+            for (const auto &pattern : runtime.getAllPatterns()) {
+                auto array = dynamic_cast<ptrn::PatternArrayStatic*>(pattern.get());
+
+                if (pattern->getVariableName() == "bytes" && array != nullptr) {
+                    array->forEachEntry(0, array->getEntryCount(), [&](u64 index, ptrn::Pattern *entry) {
+                        if (index == 2)
+                            result[0] = entry->getFormattedValue();
+                        else if (index == 3)
+                            result[1] = entry->getFormattedValue();
+                    });
+                    found[0] = true;
+                } else if (pattern->getVariableName() == "pairs" && array != nullptr) {
+                    array->forEachEntry(0, array->getEntryCount(), [&](u64 index, ptrn::Pattern *entry) {
+                        if (auto pair = dynamic_cast<ptrn::Iteratable*>(entry); pair != nullptr && index == 1)
+                            result[2] = pair->getEntry(1)->getFormattedValue();
+                    });
+                    found[1] = true;
+                } else if (pattern->getVariableName() == "value") {
+                    result[3] = pattern->getFormattedValue();
+                    found[2] = true;
+                }
+            }
+
+            if (!found[0] || !found[1] || !found[2])
+                return std::nullopt;
+
+            return result;
+        }
+    };
+
+}
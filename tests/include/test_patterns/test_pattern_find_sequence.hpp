@@ -0,0 +1,69 @@
+#pragma once
+
+#include "test_pattern.hpp"
+
+#include <array>
+#include <vector>
+
+namespace pl::test {
+
+    class TestPatternFindSequence : public TestPattern {
+    public:
+        TestPatternFindSequence() : TestPattern("FindSequence") {
+
+        }
+        ~TestPatternFindSequence() override = default;
+
+        [[nodiscard]] std::string getSourceCode() const override {
+            return R"(
+                // find_sequence_in_range(occurrence_index, start_offset, end_offset, bytes...)
+                // An end offset that isn't past the start offset searches until the end of the data
+
+                std::assert(builtin::std::mem::find_sequence_in_range(0, 0x00, 0x00, 0x49, 0x44, 0x41, 0x54) == 37, "First IDAT chunk");
+                std::assert(builtin::std::mem::find_sequence_in_range(1, 0x00, 0x00, 0x49, 0x44, 0x41, 0x54) == 8241, "Second IDAT chunk");
+                std::assert(builtin::std::mem::find_sequence_in_range(0, 38, 0x00, 0x49, 0x44, 0x41, 0x54) == 8241, "IDAT chunk after the start offset");
+                std::assert(builtin::std::mem::find_sequence_in_range(21, 0x00, 0x00, 0x49, 0x44, 0x41, 0x54) == -1, "No more IDAT chunks");
+
+                // Matches ending exactly at the end offset
+                std::assert(builtin::std::mem::find_sequence_in_range(0, 0x00, 0x00, 0xAE, 0x42, 0x60, 0x82) == 168415, "Sequence at the end of the data");
+                std::assert(builtin::std::mem::find_sequence_in_range(0, 0x00, 0x10, 0x49, 0x48, 0x44, 0x52) == 0x0C, "Sequence ending at the end offset");
+                std::assert(builtin::std::mem::find_sequence_in_range(0, 0x00, 0x0F, 0x49, 0x48, 0x44, 0x52) == -1, "Sequence ending past the end offset");
+                std::assert(builtin::std::mem::find_sequence_in_range(0, 0x00, 0x0D, 0x49) == 0x0C, "Single byte ending at the end offset");
+                std::assert(builtin::std::mem::find_sequence_in_range(0, 0x00, 0x0C, 0x49) == -1, "Single byte at the end offset");
+
+                std::assert(builtin::std::mem::find_string_in_range(0, 0x00, 0x00, "IEND") == 168411, "IEND chunk");
+            )";
+        }
+
+        [[nodiscard]] bool runRuntimeChecks(PatternLanguage &runtime) const override {
+            wolv::util::unused(runtime);
+
+            // Data spanning multiple search chunks with sequences placed right across the chunk boundaries
+            std::vector<u8> data(0x200010, 0x00);
+            for (const u64 address : { 0x10, 0xFFFFE, 0x1FFFFF, 0x20000C }) {
+                constexpr static std::array<u8, 4> Sequence = { 0xDE, 0xAD, 0xBE, 0xEF };
+                std::copy(Sequence.begin(), Sequence.end(), data.begin() + address);
+            }
+
+            return executeOnData(data, R"(
+                std::assert(builtin::std::mem::find_sequence_in_range(0, 0x00, 0x00, 0xDE, 0xAD, 0xBE, 0xEF) == 0x10, "Sequence in the first chunk");
+                std::assert(builtin::std::mem::find_sequence_in_range(1, 0x00, 0x00, 0xDE, 0xAD, 0xBE, 0xEF) == 0xFFFFE, "Sequence crossing the first chunk boundary");
+                std::assert(builtin::std::mem::find_sequence_in_range(2, 0x00, 0x00, 0xDE, 0xAD, 0xBE, 0xEF) == 0x1FFFFF, "Sequence crossing the second chunk boundary");
+                std::assert(builtin::std::mem::find_sequence_in_range(3, 0x00, 0x00, 0xDE, 0xAD, 0xBE, 0xEF) == 0x20000C, "Sequence at the end of the data");
+                std::assert(builtin::std::mem::find_sequence_in_range(4, 0x00, 0x00, 0xDE, 0xAD, 0xBE, 0xEF) == -1, "No more sequences");
+
+                std::assert(builtin::std::mem::find_sequence_in_range(0, 0x11, 0x00, 0xDE, 0xAD, 0xBE, 0xEF) == 0xFFFFE, "Sequence after an unaligned start offset");
+                std::assert(builtin::std::mem::find_sequence_in_range(0, 0x100000, 0x00, 0xDE, 0xAD, 0xBE, 0xEF) == 0x1FFFFF, "Sequence crossing a chunk boundary after the start offset");
+                std::assert(builtin::std::mem::find_sequence_in_range(0, 0x20, 0x100002, 0xDE, 0xAD, 0xBE, 0xEF) == 0xFFFFE, "Sequence crossing a chunk boundary ending at the end offset");
+                std::assert(builtin::std::mem::find_sequence_in_range(0, 0x20, 0x100001, 0xDE, 0xAD, 0xBE, 0xEF) == -1, "Sequence crossing a chunk boundary ending past the end offset");
+                std::assert(builtin::std::mem::find_sequence_in_range(0, 0x20, 0x200003, 0xDE, 0xAD, 0xBE, 0xEF) == 0xFFFFE, "Sequence found before the end offset");
+                std::assert(builtin::std::mem::find_sequence_in_range(1, 0x20, 0x200003, 0xDE, 0xAD, 0xBE, 0xEF) == 0x1FFFFF, "Sequence in the last chunk ending at the end offset");
+
+                std::assert(builtin::std::mem::find_sequence_in_range(1, 0x00, 0x00, 0xEF) == 0x100001, "Single byte right after the first chunk boundary");
+                std::assert(builtin::std::mem::find_sequence_in_range(2, 0x00, 0x00, 0xDE) == 0x1FFFFF, "Single byte at the end of the second chunk");
+                std::assert(builtin::std::mem::find_sequence_in_range(3, 0x00, 0x00, 0xEF) == 0x20000F, "Single byte at the end of the data");
+            )");
+        }
+    };
+
+}
@@ -0,0 +1,76 @@
+#pragma once
+
+#include "test_pattern.hpp"
+
+#include <array>
+#include <vector>
+
+namespace pl::test {
+
+    class TestPatternFindSignatures : public TestPattern {
+    public:
+        TestPatternFindSignatures() : TestPattern("FindSignatures") {
+
+        }
+        ~TestPatternFindSignatures() override = default;
+
+        [[nodiscard]] std::string getSourceCode() const override {
+            return R"(
+                // find_signatures_in_range(section_id, start_offset, end_offset, signatures...) -> hit_count
+                // Hits are written to the section as pairs of start address and signature index, ordered by address
+
+                u128 section = builtin::std::mem::create_section("hits");
+                std::assert(builtin::std::mem::find_signatures_in_range(section, 0x00, 0x00, "49 48 44 52", "4? 44 41 54", "?9 45 4E 44", "89 50 4E ?7", "49 ?? 41 54", "ae 42 60 82") == 46, "Signature hit count");
+
+                u64 hits[46 * 2] @ 0x00 in section;
+                std::assert(hits[0] == 0x00 && hits[1] == 3, "Signature with a wildcard in the last nibble");
+                std::assert(hits[2] == 0x0C && hits[3] == 0, "Signature without wildcards");
+                std::assert(hits[4] == 37 && hits[5] == 1, "Signature with a wildcard in the first byte");
+                std::assert(hits[6] == 37 && hits[7] == 4, "Signature with a wildcard byte");
+                std::assert(hits[8] == 8241 && hits[9] == 1, "Same signature matching again");
+                std::assert(hits[88] == 168411 && hits[89] == 2, "Signature with a wildcard in the first nibble");
+                std::assert(hits[90] == 168415 && hits[91] == 5, "Lower case signature at the end of the data");
+
+                // Nibble wildcards only match the nibble they're placed on
+                u128 otherSection = builtin::std::mem::create_section("other hits");
+                std::assert(builtin::std::mem::find_signatures_in_range(otherSection, 0x00, 0x00, "5? 44 41 54", "?A 45 4E 44", "89 50 4E ?8") == 0, "Nibble wildcards matching the other nibble");
+                std::assert(builtin::std::mem::find_signatures_in_range(otherSection, 0x20, 0x2000, "4? 44 41 54", "49 ?? 41 54") == 2, "Signatures inside the range");
+                std::assert(builtin::std::mem::find_signatures_in_range(otherSection, 0x26, 0x2034, "4? 44 41 54") == 0, "Signatures crossing the range");
+            )";
+        }
+
+        [[nodiscard]] bool runRuntimeChecks(PatternLanguage &runtime) const override {
+            wolv::util::unused(runtime);
+
+            // Data spanning multiple search chunks with signatures placed right across the chunk boundaries
+            std::vector<u8> data(0x200010, 0x00);
+            for (const u64 address : { 0xFFFFE, 0x1FFFFF, 0x20000C }) {
+                constexpr static std::array<u8, 4> Signature = { 0xDE, 0xAD, 0xBE, 0xEF };
+                std::copy(Signature.begin(), Signature.end(), data.begin() + address);
+            }
+
+            return executeOnData(data, R"(
+                u128 section = builtin::std::mem::create_section("hits");
+                std::assert(builtin::std::mem::find_signatures_in_range(section, 0x00, 0x00, "DE AD BE EF") == 3, "Signatures crossing chunk boundaries");
+                std::assert(builtin::std::mem::find_signatures_in_range(section, 0xFFFFF, 0x00, "DE AD BE EF") == 2, "Signatures after the start offset");
+                std::assert(builtin::std::mem::find_signatures_in_range(section, 0x00, 0x200003, "DE AD BE EF") == 2, "Signature crossing a chunk boundary ending at the end offset");
+                std::assert(builtin::std::mem::find_signatures_in_range(section, 0x00, 0x200002, "DE AD BE EF") == 1, "Signature crossing a chunk boundary ending past the end offset");
+
+                // More signatures than fit into a single word of the scanner
+                std::assert(builtin::std::mem::find_signatures_in_range(section, 0x00, 0x00,
+                    "DE AD BE EF", "D? A? B? E?", "01 02 03 04", "11 12 13 14", "21 22 23 24", "31 32 33 34",
+                    "41 42 43 44", "51 52 53 54", "61 62 63 64", "71 72 73 74", "81 82 83 84", "91 92 93 94",
+                    "A1 A2 A3 A4", "B1 B2 B3 B4", "C1 C2 C3 C4", "?E ?D ?E ?F", "DE ?? BE EF") == 12, "Signatures in multiple words");
+
+                u64 hits[12 * 2] @ 0x00 in section;
+                std::assert(hits[0] == 0xFFFFE && hits[1] == 0, "First signature at the first chunk boundary");
+                std::assert(hits[2] == 0xFFFFE && hits[3] == 1, "Nibble wildcard signature at the first chunk boundary");
+                std::assert(hits[4] == 0xFFFFE && hits[5] == 15, "Nibble wildcard signature in the second word");
+                std::assert(hits[6] == 0xFFFFE && hits[7] == 16, "Byte wildcard signature in the second word");
+                std::assert(hits[8] == 0x1FFFFF && hits[9] == 0, "First signature at the second chunk boundary");
+                std::assert(hits[22] == 0x20000C && hits[23] == 16, "Last signature at the end of the data");
+            )");
+        }
+    };
+
+}
@@ -0,0 +1,66 @@
+#pragma once
+
+#include "test_pattern.hpp"
+
+namespace pl::test {
+
+    class TestPatternHashVectors : public TestPattern {
+    public:
+        TestPatternHashVectors() : TestPattern("HashVectors") {
+        }
+        ~TestPatternHashVectors() override = default;
+
+        [[nodiscard]] std::string getSourceCode() const override {
+            return R"(
+                #pragma pattern_limit 2000000
+
+                // crc32(pattern, init, poly, xorout, reflect_in, reflect_out)
+                // crc64(pattern, init, poly, xorout, reflect_in, reflect_out)
+
+                // Check values of the "123456789" test string
+                fn check_vectors() {
+                    u128 section = builtin::std::mem::create_section("check");
+                    builtin::std::mem::copy_value_to_section("123456789", section, 0x00);
+
+                    char check[9] @ 0x00 in section;
+
+                    std::assert(builtin::std::hash::crc32(check, 0xFFFFFFFF, 0x04C11DB7, 0xFFFFFFFF, true, true) == 0xCBF43926, "CRC-32 check value");
+                    std::assert(builtin::std::hash::crc64(check, 0x00, 0x42F0E1EBA9EA3693, 0x00, false, false) == 0x6C40DF5F0B497347, "CRC-64/ECMA-182 check value");
+                    std::assert(builtin::std::hash::crc64(check, 0xFFFFFFFFFFFFFFFF, 0x42F0E1EBA9EA3693, 0xFFFFFFFFFFFFFFFF, true, true) == 0x995DC9BBDF1939FA, "CRC-64/XZ check value");
+                    std::assert(builtin::std::hash::adler32(check) == 0x091E01DE, "Adler-32 check value");
+                    std::assert(builtin::std::hash::xxh64(check, 0) == 0x8CB841DB40E6AE83, "XXH64 check value");
+                    std::assert(builtin::std::hash::xxh64(check, 0x1234) == 0x9A11C171131F51EC, "XXH64 check value with seed");
+                    std::assert(builtin::std::hash::sha1(check) == "f7c3bc1d808e04732adf679965ccc34ca7ae3441", "SHA-1 check value");
+                    std::assert(builtin::std::hash::sha256(check) == "15e2b0d3c33891ebb0f1ef609ec419420c20e320ce94c65fbc8c3312448eb225", "SHA-256 check value");
+                };
+                check_vectors();
+
+                // Data spanning many blocks
+                u8 data[builtin::std::mem::size()] @ 0x00;
+
+                std::assert(builtin::std::hash::crc32(data, 0xFFFFFFFF, 0x04C11DB7, 0xFFFFFFFF, true, true) == 0x4B1B760F, "CRC-32 of the data");
+                std::assert(builtin::std::hash::crc64(data, 0x00, 0x42F0E1EBA9EA3693, 0x00, false, false) == 0x472C2C347621724D, "CRC-64/ECMA-182 of the data");
+                std::assert(builtin::std::hash::crc64(data, 0xFFFFFFFFFFFFFFFF, 0x42F0E1EBA9EA3693, 0xFFFFFFFFFFFFFFFF, true, true) == 0xC07BEA67635CC9ED, "CRC-64/XZ of the data");
+                std::assert(builtin::std::hash::adler32(data) == 0x0DCB481B, "Adler-32 of the data");
+                std::assert(builtin::std::hash::xxh64(data, 0) == 0x1EE423FE7014312F, "XXH64 of the data");
+                std::assert(builtin::std::hash::sha1(data) == "ef8a7b1c2ce8d00b4f484eafc9eab8b5badd8e70", "SHA-1 of the data");
+                std::assert(builtin::std::hash::sha256(data) == "6f5c4423afcab45e36dd5047af5da994ef40f255ad24a5f362dc58881356a950", "SHA-256 of the data");
+
+                // Data spanning multiple chunks
+                u128 section = builtin::std::mem::create_section("chunks");
+                for (u8 i = 0, i < 7, i += 1)
+                    builtin::std::mem::copy_to_section(0, 0x00, section, i * builtin::std::mem::size(), builtin::std::mem::size());
+
+                u8 repeated[builtin::std::mem::size() * 7] @ 0x00 in section;
+
+                std::assert(builtin::std::hash::crc32(repeated, 0xFFFFFFFF, 0x04C11DB7, 0xFFFFFFFF, true, true) == 0xC16A7FE6, "CRC-32 across chunks");
+                std::assert(builtin::std::hash::crc64(repeated, 0xFFFFFFFFFFFFFFFF, 0x42F0E1EBA9EA3693, 0xFFFFFFFFFFFFFFFF, true, true) == 0x3438D3E402953AF5, "CRC-64/XZ across chunks");
+                std::assert(builtin::std::hash::adler32(repeated) == 0x4AEFF8C6, "Adler-32 across chunks");
+                std::assert(builtin::std::hash::xxh64(repeated, 0) == 0x3DF85871964245FA, "XXH64 across chunks");
+                std::assert(builtin::std::hash::sha1(repeated) == "ef791098d60d54efa3358239a8ea0b8766116d2d", "SHA-1 across chunks");
+                std::assert(builtin::std::hash::sha256(repeated) == "6a92b42a5fcd3b65888888f186164c372d4c415031ef07a0150afde4a1ab1425", "SHA-256 across chunks");
+            )";
+        }
+    };
+
+}
@@ -0,0 +1,304 @@
+#pragma once
+
+#include "test_pattern.hpp"
+
+#include <pl/core/evaluator.hpp>
+#include <pl/formatters/formatter_html.hpp>
+
+#include <algorithm>
+#include <optional>
+#include <string>
+#include <vector>
+
+namespace pl::test {
+
+    class TestPatternHtmlFormat : public TestPattern {
+    public:
+        TestPatternHtmlFormat() : TestPattern("HtmlFormat") {
+
+        }
+        ~TestPatternHtmlFormat() override = default;
+
+        [[nodiscard]] std::string getSourceCode() const override {
+            return R"(
+                fn markup(auto value) {
+                    return "<a href=\"x\">&\nb";
+                };
+
+                struct Header {
+                    u32 magic;
+                    u16 version [[format("markup")]];
+                };
+
+                struct Pair {
+                    u16 first;
+                    u16 second;
+                };
+
+                Header header @ 0x1004;
+                u64 overlapping @ 0x1006;
+                u8 bytes[0x20] @ 0x1013;
+                u32 straddling @ 0x2002;
+                Pair pairs[0x10] @ 0x2FF3;
+                u16 last @ 0x37FE;
+            )";
+        }
+
+        // The data starts at an address that isn't a multiple of 16, so rows and 4 KiB blocks are offset from the addresses
+        [[nodiscard]] bool runRuntimeChecks(PatternLanguage &runtime) const override {
+            auto evaluator = runtime.getInternals().evaluator;
+
+            std::vector<u8> data(evaluator->getDataSize());
+            evaluator->readData(0x00, data.data(), data.size(), ptrn::Pattern::MainSectionId);
+
+            PatternLanguage htmlRuntime;
+            htmlRuntime.setDataSource(BaseAddress, DataSize, [&data](u64 address, u8 *buffer, u64 size) {
+                std::copy_n(data.begin() + address, size, buffer);
+            });
+
+            if (!htmlRuntime.executeString(this->getSourceCode()))
+                return false;
+
+            gen::fmt::FormatterHtml formatter;
+            const auto output = toString(formatter.format(htmlRuntime));
+
+            const auto rows = parseRows(output);
+            if (!rows.has_value() || !checkRows(htmlRuntime, data, *rows, BaseAddress, BaseAddress + DataSize))
+                return false;
+
+            // Titles are escaped, the line break in the formatted value turns into a space
+            if (output.contains("<a href") || !output.contains("&lt;a href=&quot;x&quot;&gt;&amp; b"))
+                return false;
+
+            return checkPages(htmlRuntime, output);
+        }
+
+    private:
+        constexpr static u64 BaseAddress    = 0x1004;
+        constexpr static u64 DataSize       = 0x2800;
+        constexpr static u64 BlockSize      = 0x1000;
+
+        struct Run {
+            u64 start, end;
+            std::optional<std::vector<std::string>> titleLines;
+        };
+
+        struct Row {
+            u64 address;
+            std::string text;
+            std::vector<Run> runs;
+        };
+
+        [[nodiscard]] static std::string toString(const std::vector<u8> &output) {
+            return { output.begin(), output.end() };
+        }
+
+        [[nodiscard]] static std::vector<std::string> splitTitle(std::string_view title) {
+            std::vector<std::string> lines;
+            while (true) {
+                const auto position = title.find("&#10;");
+                lines.emplace_back(title.substr(0, position));
+                if (position == std::string_view::npos)
+                    break;
+
+                title.remove_prefix(position + 5);
+            }
+
+            std::ranges::sort(lines);
+            return lines;
+        }
+
+        // Splits the rows into their runs and the plain text they show, with all tags removed
+        [[nodiscard]] static std::optional<std::vector<Row>> parseRows(const std::string &output) {
+            constexpr static std::string_view RowStart = R"html(<div class="pattern_language_row"><span class="pattern_language_address">)html";
+            constexpr static std::string_view RunStart = R"html(<span style="background-color: #)html";
+
+            std::vector<Row> rows;
+            for (auto position = output.find(RowStart); position != std::string::npos; position = output.find(RowStart, position)) {
+                position += RowStart.size();
+                const auto rowEnd = output.find("</div>", position);
+                const auto line = std::string_view(output).substr(position, rowEnd - position);
+                position = rowEnd;
+
+                // The header row doesn't have an address
+                if (line.starts_with(' '))
+                    continue;
+
+                Row row = { std::stoull(std::string(line.substr(0, 8)), nullptr, 16), "", { } };
+                auto content = line.substr(std::string_view("00000000</span> ").size());
+
+                u64 address = row.address;
+                while (!content.empty()) {
+                    std::optional<std::vector<std::string>> titleLines;
+                    std::string_view bytes;
+
+                    if (content.starts_with(RunStart)) {
+                        const auto titleStart = content.find("title=\"") + 7;
+                        const auto titleEnd = content.find("\">", titleStart);
+                        const auto bytesEnd = content.find("</span>", titleEnd);
+
+                        titleLines = splitTitle(content.substr(titleStart, titleEnd - titleStart));
+                        bytes = content.substr(titleEnd + 2, bytesEnd - titleEnd - 2);
+                        content.remove_prefix(bytesEnd + 7);
+                    } else {
+                        const auto bytesEnd = content.find('<');
+                        bytes = content.substr(0, bytesEnd);
+                        content.remove_prefix(bytesEnd == std::string_view::npos ? content.size() : bytesEnd);
+                    }
+
+                    row.text += bytes;
+
+                    // Separators between runs are written outside of them
+                    const auto byteCount = std::ranges::count_if(bytes, [](char c) { return c != ' '; }) / 2;
+                    if (byteCount == 0)
+                        continue;
+
+                    row.runs.push_back({ address, address + byteCount, titleLines });
+                    address += byteCount;
+                }
+
+                rows.push_back(std::move(row));
+            }
+
+            return rows;
+        }
+
+        [[nodiscard]] static std::string escape(std::string_view text) {
+            std::string result;
+            for (const char c : text) {
+                switch (c) {
+                    case '<':  result += "&lt;";   break;
+                    case '>':  result += "&gt;";   break;
+                    case '&':  result += "&amp;";  break;
+                    case '"':  result += "&quot;"; break;
+                    case '\n': result += ' ';      break;
+                    default:   result += c;        break;
+                }
+            }
+
+            return result;
+        }
+
+        [[nodiscard]] static std::optional<std::vector<std::string>> getTitleLines(const PatternLanguage &runtime, u64 address) {
+            const auto entries = runtime.findPatternsAtAddress(address);
+            if (entries.empty())
+                return std::nullopt;
+
+            std::vector<std::string> lines;
+            for (const auto &entry : entries)
+                lines.push_back(escape(fmt::format("{} {} | {}", entry.pattern->getFormattedName(), entry.pattern->getVariableName(), entry.pattern->getFormattedValueAt(entry.offset))));
+
+            std::ranges::sort(lines);
+            return lines;
+        }
+
+        [[nodiscard]] static bool checkRows(const PatternLanguage &runtime, const std::vector<u8> &data, const std::vector<Row> &rows, u64 start, u64 end) {
+            u64 address = start;
+            for (const auto &row : rows) {
+                if (row.address != address || row.runs.empty() || row.runs.front().start != address)
+                    return false;
+
+                const auto rowEnd = std::min(address + 0x10, end);
+
+                // The wider gap always sits in front of addresses ending in 8, no matter where the row starts
+                std::string expectedText;
+                for (u64 byte = address; byte < rowEnd; byte++) {
+                    if (byte != address)
+                        expectedText += (byte & 0x0F) == 0x08 ? "  " : " ";
+                    expectedText += fmt::format("{:02X}", data[byte]);
+                }
+
+                if (row.text != expectedText || row.runs.back().end != rowEnd)
+                    return false;
+
+                for (u64 i = 0; i < row.runs.size(); i++) {
+                    const auto &run = row.runs[i];
+
+                    // Every byte of a run is covered by exactly the patterns listed in its title
+                    for (u64 byte = run.start; byte < run.end; byte++) {
+                        if (getTitleLines(runtime, byte) != run.titleLines)
+                            return false;
+                    }
+
+                    // Runs inside of a row only end where the patterns change
+                    if (i > 0 && run.titleLines == row.runs[i - 1].titleLines)
+                        return false;
+                }
+
+                address = rowEnd;
+            }
+
+            if (address != end)
+                return false;
+
+            // Blocks start on rows as well. Patterns crossing into the next block continue there with the same title
+            for (const auto boundary : { start + BlockSize, start + BlockSize * 2 }) {
+                const auto row = std::ranges::find_if(rows, [&](const Row &row) { return row.address == boundary; });
+                if (row == rows.begin() || row == rows.end())
+                    return false;
+
+                const auto &before = std::prev(row)->runs.back(), &after = row->runs.front();
+                if (!after.titleLines.has_value() || before.titleLines != after.titleLines)
+                    return false;
+            }
+
+            return true;
+        }
+
+        // Pages split the rows of the whole document and link to their neighbours
+        [[nodiscard]] static bool checkPages(const PatternLanguage &runtime, const std::string &fullOutput) {
+            gen::fmt::FormatterHtml formatter;
+
+            formatter.setPageSize(0x1001);
+            if (formatter.getPageSize() != 0x1010)
+                return false;
+
+            formatter.setPageSize(BlockSize);
+            const auto pageCount = formatter.getPageCount(runtime);
+            if (pageCount != (DataSize + BlockSize - 1) / BlockSize)
+                return false;
+
+            const auto getPageLink = [](u64 page) { return fmt::format("page_{}.html", page); };
+
+            std::vector<Row> pageRows;
+            for (u64 page = 0; page < pageCount; page++) {
+                std::vector<u8> buffer;
+                {
+                    gen::fmt::BufferedOutput output([&](const u8 *data, size_t size) {
+                        buffer.insert(buffer.end(), data, data + size);
+                    });
+
+                    formatter.formatPage(runtime, page, output, getPageLink);
+                }
+
+                const auto output = toString(buffer);
+                if (!output.contains(fmt::format("Page {} / {}", page + 1, pageCount)))
+                    return false;
+                if (output.contains(R"html(&lt; Previous</a>)html") != (page > 0) || output.contains(R"html(Next &gt;</a>)html") != (page + 1 < pageCount))
+                    return false;
+                if (page > 0 && !output.contains(fmt::format(R"html(<a href="{}">&lt; Previous</a>)html", getPageLink(page - 1))))
+                    return false;
+                if (page + 1 < pageCount && !output.contains(fmt::format(R"html(<a href="{}">Next &gt;</a>)html", getPageLink(page + 1))))
+                    return false;
+
+                const auto rows = parseRows(output);
+                if (!rows.has_value() || rows->empty() || rows->front().address != BaseAddress + page * BlockSize)
+                    return false;
+
+                pageRows.insert(pageRows.end(), rows->begin(), rows->end());
+            }
+
+            const auto fullRows = parseRows(fullOutput);
+            if (!fullRows.has_value() || fullRows->size() != pageRows.size())
+                return false;
+
+            for (u64 i = 0; i < pageRows.size(); i++) {
+                if (pageRows[i].address != (*fullRows)[i].address || pageRows[i].text != (*fullRows)[i].text)
+                    return false;
+            }
+
+            return true;
+        }
+    };
+
+}
@@ -0,0 +1,168 @@
+#pragma once
+
+#include "test_pattern.hpp"
+
+#include <pl/helpers/interval_index.hpp>
+
+#include <algorithm>
+#include <random>
+#include <set>
+#include <tuple>
+#include <vector>
+
+namespace pl::test {
+
+    class TestPatternIntervalIndex : public TestPattern {
+    public:
+        TestPatternIntervalIndex() : TestPattern("IntervalIndex") {
+
+        }
+        ~TestPatternIntervalIndex() override = default;
+
+        [[nodiscard]] std::string getSourceCode() const override {
+            return R"(
+                struct Inner {
+                    u16 value;
+                    u8 flags;
+                };
+
+                struct Outer {
+                    u32 magic;
+                    Inner inner;
+                };
+
+                union Overlap {
+                    u32 whole;
+                    u16 halves[2];
+                };
+
+                Outer outer @ 0x00;
+                u32 overlapping @ 0x02;
+                Overlap overlap @ 0x10;
+                Inner inners[64] @ 0x100;
+            )";
+        }
+
+        [[nodiscard]] bool runRuntimeChecks(PatternLanguage &runtime) const override {
+            return checkIndex() && checkPatterns(runtime);
+        }
+
+    private:
+        using Index = hlp::IntervalIndex<u32>;
+        using Result = std::tuple<u64, u64, u32>;
+        using Names = std::set<std::pair<std::string, u64>>;
+
+        // Compares the index against a linear search for intervals of different lengths, which makes lookups use both the
+        // linear scan and the tree search
+        [[nodiscard]] static bool checkIndex() {
+            std::mt19937_64 random(1234);
+
+            for (const u32 count : { 0, 1, 2, 3, 7, 8, 9, 31, 32, 33, 64, 65, 200, 1000 }) {
+                for (const u64 maxLength : { 1, 16, 0x1000 }) {
+                    std::vector<Index::Interval> intervals;
+                    for (u32 i = 0; i < count; i++) {
+                        const u64 start  = random() % 0x1000;
+                        const u64 length = random() % maxLength;
+                        intervals.push_back({ start, start + length, i });
+                    }
+
+                    const Index index(intervals);
+                    if (index.size() != count)
+                        return false;
+
+                    for (u32 query = 0; query < 200; query++) {
+                        // Also query right at the ends of intervals, where off by one errors would show up
+                        u64 start = random() % 0x1100;
+                        if (count > 0 && query % 4 >= 2)
+                            start = intervals[random() % count].end + (query % 4 == 2 ? 0 : 1);
+
+                        const u64 end = start + (query % 2 == 0 ? 0 : random() % 0x80);
+
+                        std::vector<Result> expected, found;
+                        for (const auto &interval : intervals) {
+                            if (interval.start <= end && start <= interval.end)
+                                expected.emplace_back(interval.start, interval.end, interval.value);
+                        }
+
+                        u64 previousStart = 0;
+                        bool ordered = true;
+                        index.findOverlapping(start, end, [&](u64 intervalStart, u64 intervalEnd, u32 value) {
+                            ordered = ordered && previousStart <= intervalStart;
+                            previousStart = intervalStart;
+
+                            found.emplace_back(intervalStart, intervalEnd, value);
+                        });
+
+                        std::sort(expected.begin(), expected.end());
+                        std::sort(found.begin(), found.end());
+                        if (!ordered || found != expected)
+                            return false;
+                    }
+                }
+            }
+
+            return true;
+        }
+
+        [[nodiscard]] static Names findNames(PatternLanguage &runtime, u64 address) {
+            Names result;
+            for (const auto &entry : runtime.findPatternsAtAddress(address))
+                result.emplace(entry.pattern->getVariableName(), entry.offset);
+
+            return result;
+        }
+
+        [[nodiscard]] static bool checkPatterns(PatternLanguage &runtime) {
+            // Nested, overlapping and array patterns
+            if (findNames(runtime, 0x00) != Names { { "magic", 0x00 } })
+                return false;
+            if (findNames(runtime, 0x03) != Names { { "magic", 0x00 }, { "overlapping", 0x02 } })
+                return false;
+            if (findNames(runtime, 0x04) != Names { { "value", 0x04 }, { "overlapping", 0x02 } })
+                return false;
+            if (findNames(runtime, 0x06) != Names { { "flags", 0x06 } })
+                return false;
+            if (!findNames(runtime, 0x07).empty())
+                return false;
+            if (findNames(runtime, 0x12) != Names { { "whole", 0x10 }, { "halves", 0x12 } })
+                return false;
+            if (findNames(runtime, 0x100 + 37 * 3 + 2) != Names { { "flags", 0x100 + 37 * 3 + 2 } })
+                return false;
+            if (findNames(runtime, 0x100 + 63 * 3) != Names { { "value", 0x100 + 63 * 3 } })
+                return false;
+            if (!findNames(runtime, 0x100 + 64 * 3).empty())
+                return false;
+
+            // Ranges need to produce the same patterns as looking up every address on its own
+            for (const auto &[start, end] : { std::pair<u64, u64>{ 0x00, 0x20 }, { 0x0F, 0x11 }, { 0xF0, 0x1D0 }, { 0x105, 0x105 } }) {
+                u64 address = start;
+                for (const auto &span : runtime.getPatternsInRange(start, end)) {
+                    if (span.start < address || span.end < span.start || span.end > end)
+                        return false;
+
+                    for (; address < span.start; address++) {
+                        if (!findNames(runtime, address).empty())
+                            return false;
+                    }
+
+                    Names names;
+                    for (const auto &entry : span.patterns)
+                        names.emplace(entry.pattern->getVariableName(), entry.offset);
+
+                    for (; address <= span.end; address++) {
+                        if (findNames(runtime, address) != names)
+                            return false;
+                    }
+                }
+
+                for (; address <= end; address++) {
+                    if (!findNames(runtime, address).empty())
+                        return false;
+                }
+            }
+
+            return true;
+        }
+    };
+
+}
@@ -0,0 +1,111 @@
+#pragma once
+
+#include "test_pattern.hpp"
+
+#include <pl/formatters/formatter_json.hpp>
+
+#include <string>
+#include <vector>
+
+namespace pl::test {
+
+    class TestPatternJsonGolden : public TestPattern {
+    public:
+        TestPatternJsonGolden() : TestPattern("JsonGolden") {
+
+        }
+        ~TestPatternJsonGolden() override = default;
+
+        [[nodiscard]] std::string getSourceCode() const override {
+            return R"(
+                struct Empty {
+                };
+
+                struct Chunk {
+                    be u32 length;
+                    char type[4];
+                };
+
+                struct Header {
+                    u8 signature[8];
+                    Chunk chunk;
+                    Empty nothing;
+                    u8 none[0];
+                };
+
+                Header header @ 0x00;
+                Chunk chunks[2] @ 0x21;
+                Empty alone @ 0x40;
+                be u16 words[0] @ 0x40;
+            )";
+        }
+
+        [[nodiscard]] bool runRuntimeChecks(PatternLanguage &runtime) const override {
+            gen::fmt::FormatterJson formatter;
+
+            // The whole result at once
+            const auto result = formatter.format(runtime);
+            if (std::string(result.begin(), result.end()) != Golden)
+                return false;
+
+            // Streamed through a buffer much smaller than most lines, so lines and held back commas get split across writes
+            for (const bool parallel : { false, true }) {
+                formatter.enableParallelFormatting(parallel);
+
+                std::string streamed;
+                {
+                    gen::fmt::BufferedOutput output([&](const u8 *data, size_t size) {
+                        streamed.append(reinterpret_cast<const char*>(data), size);
+                    }, 7);
+
+                    formatter.format(runtime, output);
+                }
+
+                if (streamed != Golden)
+                    return false;
+            }
+
+            return true;
+        }
+
+    private:
+        // Output of the formatter before it was changed to stream its output
+        constexpr static auto Golden = R"({
+    "header": {
+        "signature": [
+            137,
+            80,
+            78,
+            71,
+            13,
+            10,
+            26,
+            10
+        ],
+        "chunk": {
+            "length": 13,
+            "type": "IHDR"
+        },
+        "nothing": {
+        },
+        "none": [
+        ]
+    },
+    "chunks": [
+        {
+            "length": 8192,
+            "type": "IDAT"
+        },
+        {
+            "length": 2013392093,
+            "type": "w\xBC\xDC\xD4"
+        }
+    ],
+    "alone": {
+    },
+    "words": [
+    ]
+})";
+    };
+
+}
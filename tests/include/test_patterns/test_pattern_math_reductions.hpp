@@ -0,0 +1,69 @@
+#pragma once
+
+#include "test_pattern.hpp"
+
+namespace pl::test {
+
+    class TestPatternMathReductions : public TestPattern {
+    public:
+        TestPatternMathReductions() : TestPattern("MathReductions") {
+        }
+        ~TestPatternMathReductions() override = default;
+
+        [[nodiscard]] std::string getSourceCode() const override {
+            return R"(
+                // accumulate(start, end, size, section, operation, endian)
+                // Operations: Add = 0, Multiply = 1, Modulo = 2, Min = 3, Max = 4, Xor = 5, PopCount = 6. Endian: Big = 1, Little = 2
+                // The result starts out as the first value. It used to start out as 0, which made Multiply, Modulo and Min always return 0
+
+                // Value size without a vectorized reduction
+                std::assert(builtin::std::math::accumulate(0x100, 0x200, 3, 0, 0, 2) == 0x30804A69, "Add of 3 byte values");
+                std::assert(builtin::std::math::accumulate(0x100, 0x200, 3, 0, 1, 2) == 0xD59D71D21ADF8EFBD76B680000000000, "Multiply of 3 byte values");
+                std::assert(builtin::std::math::accumulate(0x100, 0x200, 3, 0, 2, 2) == 0x1A035, "Modulo of 3 byte values");
+                std::assert(builtin::std::math::accumulate(0x100, 0x200, 3, 0, 3, 2) == 0x398D9, "Min of 3 byte values");
+                std::assert(builtin::std::math::accumulate(0x100, 0x200, 3, 0, 4, 2) == 0xFD91B1, "Max of 3 byte values");
+                std::assert(builtin::std::math::accumulate(0x100, 0x200, 3, 0, 5, 2) == 0xCCF245, "Xor of 3 byte values");
+                std::assert(builtin::std::math::accumulate(0x100, 0x200, 3, 0, 6, 2) == 0x48A, "PopCount of 3 byte values");
+
+                // Value size with a vectorized reduction
+                std::assert(builtin::std::math::accumulate(0x100, 0x200, 4, 0, 0, 1) == 0x2612C7632E, "Add of 4 byte values");
+                std::assert(builtin::std::math::accumulate(0x100, 0x200, 4, 0, 1, 1) == 0x10A0618521D2BEB22F4EBB8000000000, "Multiply of 4 byte values");
+                std::assert(builtin::std::math::accumulate(0x100, 0x200, 4, 0, 2, 1) == 0xBA37D29, "Modulo of 4 byte values");
+                std::assert(builtin::std::math::accumulate(0x100, 0x200, 4, 0, 3, 1) == 0x157B7CCB, "Min of 4 byte values");
+                std::assert(builtin::std::math::accumulate(0x100, 0x200, 4, 0, 4, 1) == 0xFDD929F3, "Max of 4 byte values");
+                std::assert(builtin::std::math::accumulate(0x100, 0x200, 4, 0, 5, 1) == 0xCF9E4B4C, "Xor of 4 byte values");
+                std::assert(builtin::std::math::accumulate(0x100, 0x200, 4, 0, 6, 1) == 0x48E, "PopCount of 4 byte values");
+
+                std::assert(builtin::std::math::accumulate(0x100, 0x200, 1, 0, 0, 2) == 0x92FE, "Add of 1 byte values");
+                std::assert(builtin::std::math::accumulate(0x100, 0x200, 1, 0, 3, 2) == 0x03, "Min of 1 byte values");
+                std::assert(builtin::std::math::accumulate(0x100, 0x200, 2, 0, 4, 1) == 0xFDD9, "Max of 2 byte values");
+                std::assert(builtin::std::math::accumulate(0x100, 0x200, 2, 0, 5, 1) == 0x84D2, "Xor of 2 byte values");
+                std::assert(builtin::std::math::accumulate(0x100, 0x200, 8, 0, 0, 2) == 0x1114FD5E173C676BE9, "Add of 8 byte values");
+                std::assert(builtin::std::math::accumulate(0x100, 0x200, 8, 0, 3, 2) == 0x10CED3ACCBBF10CE, "Min of 8 byte values");
+
+                // Ranges spanning multiple chunks
+                std::assert(builtin::std::math::accumulate(0x00, 0x20010, 4, 0, 0, 2) == 0x3A1C6F903F38, "Add across chunks");
+                std::assert(builtin::std::math::accumulate(0x00, 0x20010, 4, 0, 3, 2) == 0x608, "Min across chunks");
+                std::assert(builtin::std::math::accumulate(0x00, 0x20010, 4, 0, 4, 2) == 0xFFFDF8D6, "Max across chunks");
+                std::assert(builtin::std::math::accumulate(0x00, 0x20010, 4, 0, 6, 2) == 0x73D05, "PopCount across chunks");
+
+                // Byte histogram and entropy
+                fn check_histogram() {
+                    u128 section = builtin::std::mem::create_section("histogram");
+                    std::assert(builtin::std::math::byte_histogram(0x00, 0x1000, 0, section) == 0x1000, "byte_histogram total");
+
+                    u64 counts[256] @ 0x00 in section;
+                    std::assert(counts[0x00] == 103, "byte_histogram count of 0x00");
+                    std::assert(counts[0x41] == 10, "byte_histogram count of 0x41");
+                    std::assert(counts[0xFF] == 24, "byte_histogram count of 0xFF");
+                };
+                check_histogram();
+
+                std::assert(builtin::std::math::entropy(0x00, 0x08, 0) == 2.75, "entropy of PNG signature");
+                std::assert(builtin::std::math::floor(builtin::std::math::entropy(0x00, 0x1000, 0) * 1000) == 7763, "entropy of 4 KiB");
+                std::assert(builtin::std::math::entropy(0x00, 0x00, 0) == 0, "entropy of empty range");
+            )";
+        }
+    };
+
+}
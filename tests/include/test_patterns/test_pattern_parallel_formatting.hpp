@@ -0,0 +1,85 @@
+#pragma once
+
+#include "test_pattern.hpp"
+
+#include <pl/core/evaluator.hpp>
+#include <pl/formatters/formatter_html.hpp>
+#include <pl/formatters/formatter_json.hpp>
+#include <pl/formatters/formatter_yaml.hpp>
+
+#include <algorithm>
+#include <memory>
+#include <thread>
+#include <vector>
+
+namespace pl::test {
+
+    class TestPatternParallelFormatting : public TestPattern {
+    public:
+        TestPatternParallelFormatting() : TestPattern("ParallelFormatting") {
+
+        }
+        ~TestPatternParallelFormatting() override = default;
+
+        // Arrays large enough to be split up between threads next to smaller top-level patterns
+        [[nodiscard]] std::string getSourceCode() const override {
+            return R"(
+                struct Entry {
+                    u16 a;
+                    u8 b;
+                    s8 c;
+                };
+
+                struct Chunk {
+                    be u32 length;
+                    char type[4];
+                };
+
+                u8 signature[8] @ 0x00;
+                Entry entries[0x2000] @ 0x00;
+                u32 words[0x4000] @ 0x8000;
+                Chunk chunks[0x800] @ 0x18000;
+                float floats[0x600] @ 0x1C000;
+                be u64 last @ 0x291D0;
+            )";
+        }
+
+        [[nodiscard]] bool runRuntimeChecks(PatternLanguage &runtime) const override {
+            auto evaluator = runtime.getInternals().evaluator;
+
+            std::vector<u8> data(evaluator->getDataSize());
+            evaluator->readData(0x00, data.data(), data.size(), ptrn::Pattern::MainSectionId);
+
+            // Reads the data the way a file does, by seeking first and then reading from the current position
+            PatternLanguage fileRuntime;
+            fileRuntime.setDataSource(0x00, data.size(), [&data, position = u64(0)](u64 address, u8 *buffer, u64 size) mutable {
+                position = address;
+                std::this_thread::yield();
+
+                std::copy_n(data.begin() + position, size, buffer);
+            });
+
+            if (!fileRuntime.executeString(this->getSourceCode()))
+                return false;
+
+            return isSameInParallel<gen::fmt::FormatterJson>(fileRuntime) &&
+                   isSameInParallel<gen::fmt::FormatterYaml>(fileRuntime) &&
+                   isSameInParallel<gen::fmt::FormatterHtml>(fileRuntime);
+        }
+
+    private:
+        template<typename T>
+        [[nodiscard]] static bool isSameInParallel(const PatternLanguage &runtime) {
+            T formatter;
+            formatter.enableMetaInformation(true);
+
+            const auto sequential = formatter.format(runtime);
+
+            formatter.enableParallelFormatting(true);
+            const auto parallel = formatter.format(runtime);
+
+            return !sequential.empty() && parallel == sequential;
+        }
+    };
+
+}
@@ -0,0 +1,150 @@
+#pragma once
+
+#include "test_pattern.hpp"
+
+#include <pl/core/evaluator.hpp>
+#include <pl/formatters/formatter_json.hpp>
+
+#include <memory>
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace pl::test {
+
+    class TestPatternPatternSink : public TestPattern {
+    public:
+        TestPatternPatternSink() : TestPattern("PatternSink") {
+
+        }
+        ~TestPatternPatternSink() override = default;
+
+        [[nodiscard]] std::string getSourceCode() const override {
+            return R"(
+                struct Entry {
+                    u8 value;
+                };
+
+                u8 first @ 0x00;
+                u16 second @ 0x01;
+                u8 local = 0x10;
+                Entry entries[while($ < 0x20)] @ 0x10;
+                u32 last @ 0x30;
+            )";
+        }
+
+        [[nodiscard]] bool runRuntimeChecks(PatternLanguage &runtime) const override {
+            auto evaluator = runtime.getInternals().evaluator;
+
+            std::vector<u8> data(evaluator->getDataSize());
+            evaluator->readData(0x00, data.data(), data.size(), ptrn::Pattern::MainSectionId);
+
+            return checkTopLevelPatterns(data) && checkArrayEntries(data) && checkJson(runtime, data);
+        }
+
+    private:
+        using Sunk = std::vector<std::pair<std::string, u64>>;
+
+        static void setData(PatternLanguage &runtime, const std::vector<u8> &data) {
+            runtime.setDataSource(0x00, data.size(), [&data](u64 address, u8 *buffer, u64 size) {
+                std::copy_n(data.begin() + address, size, buffer);
+            });
+        }
+
+        // Placed top-level patterns arrive in order and only the ones the sink keeps stay in the results
+        [[nodiscard]] bool checkTopLevelPatterns(const std::vector<u8> &data) const {
+            PatternLanguage sinkRuntime;
+            setData(sinkRuntime, data);
+
+            Sunk sunk;
+            std::vector<std::weak_ptr<ptrn::Pattern>> released;
+            sinkRuntime.setPatternSink([&](const std::shared_ptr<ptrn::Pattern> &pattern) {
+                sunk.emplace_back(pattern->getVariableName(), pattern->getOffset());
+                if (pattern->getVariableName() == "second")
+                    return true;
+
+                released.push_back(pattern);
+                return false;
+            });
+
+            if (!sinkRuntime.executeString(this->getSourceCode()))
+                return false;
+
+            if (sunk != Sunk { { "first", 0x00 }, { "second", 0x01 }, { "entries", 0x10 }, { "last", 0x30 } })
+                return false;
+
+            const auto &patterns = sinkRuntime.getAllPatterns();
+            if (patterns.size() != 1 || patterns.front()->getVariableName() != "second" || sinkRuntime.findPatternsAtAddress(0x00).size() != 0)
+                return false;
+
+            return std::ranges::all_of(released, [](const auto &pattern) { return pattern.expired(); });
+        }
+
+        // Entries of top-level arrays arrive in order before the array itself, which only keeps the entries the sink kept
+        [[nodiscard]] bool checkArrayEntries(const std::vector<u8> &data) const {
+            PatternLanguage sinkRuntime;
+            setData(sinkRuntime, data);
+
+            Sunk sunk;
+            std::vector<std::weak_ptr<ptrn::Pattern>> released;
+            sinkRuntime.setPatternSink([&](const std::shared_ptr<ptrn::Pattern> &pattern) {
+                sunk.emplace_back(pattern->getVariableName(), pattern->getOffset());
+                if (pattern->getVariableName() == "entries" || pattern->getOffset() == 0x1F)
+                    return true;
+
+                released.push_back(pattern);
+                return false;
+            }, true);
+
+            if (!sinkRuntime.executeString(this->getSourceCode()))
+                return false;
+
+            Sunk expected = { { "first", 0x00 }, { "second", 0x01 } };
+            for (u64 i = 0; i < 0x10; i++)
+                expected.emplace_back(fmt::format("[{}]", i), 0x10 + i);
+            expected.emplace_back("entries", 0x10);
+            expected.emplace_back("last", 0x30);
+
+            if (sunk != expected)
+                return false;
+
+            const auto &patterns = sinkRuntime.getAllPatterns();
+            if (patterns.size() != 1 || patterns.front()->getVariableName() != "entries")
+                return false;
+
+            auto entries = dynamic_cast<ptrn::Iteratable*>(patterns.front().get());
+            if (entries == nullptr || entries->getEntryCount() != 1 || entries->getEntry(0)->getOffset() != 0x1F)
+                return false;
+
+            return std::ranges::all_of(released, [](const auto &pattern) { return pattern.expired(); });
+        }
+
+        // Writing the patterns as they arrive produces the same json as formatting all results at the end
+        [[nodiscard]] bool checkJson(const PatternLanguage &runtime, const std::vector<u8> &data) const {
+            gen::fmt::FormatterJson formatter;
+            formatter.enableMetaInformation(true);
+
+            std::vector<u8> streamed;
+            {
+                gen::fmt::BufferedOutput output([&](const u8 *buffer, size_t size) {
+                    streamed.insert(streamed.end(), buffer, buffer + size);
+                });
+
+                PatternLanguage sinkRuntime;
+                setData(sinkRuntime, data);
+
+                gen::fmt::FormatterJson::PatternWriter writer(formatter, output);
+                sinkRuntime.setPatternSink([&writer](const std::shared_ptr<ptrn::Pattern> &pattern) {
+                    writer.write(*pattern);
+                    return false;
+                });
+
+                if (!sinkRuntime.executeString(this->getSourceCode()))
+                    return false;
+            }
+
+            return !streamed.empty() && streamed == formatter.format(runtime);
+        }
+    };
+
+}
@@ -60,6 +60,46 @@ namespace pl::test {
                 u32 *pointerRelativeSigned : s8 @ 0x1D [[pointer_base("Rel")]];
             )";
         }
+
+        [[nodiscard]] bool runChecks(const std::vector<std::shared_ptr<ptrn::Pattern>> &patterns) const override {
+            for (const auto &pattern : patterns) {
+                auto pointer = dynamic_cast<PatternPointer*>(pattern.get());
+                if (pointer == nullptr)
+                    return false;
+
+                // The pointed at pattern is named after the pointer, also when the pointer is cloned
+                const auto expectedName = fmt::format("*({})", pointer->getVariableName());
+                if (pointer->getPointedAtPattern()->getVariableName() != expectedName)
+                    return false;
+
+                auto clone = pointer->clone();
+                if (static_cast<PatternPointer*>(clone.get())->getPointedAtPattern()->getVariableName() != expectedName)
+                    return false;
+            }
+
+            return checkUnnamedPointer();
+        }
+
+    private:
+        // Pointers without a name of their own name the pointed at pattern after their type and offset
+        [[nodiscard]] static bool checkUnnamedPointer() {
+            auto pointer = create<PatternPointer>("Ptr", "", 0x20, sizeof(u8));
+            pointer->setPointerTypePattern(create<PatternUnsigned>("u8", "", 0x20, sizeof(u8)));
+            pointer->setPointedAtPattern(create<PatternUnsigned>("u32", "", 0, sizeof(u32)));
+
+            auto clone = pointer->clone();
+            auto &pointedAt = *pointer->getPointedAtPattern();
+            if (pointedAt.getVariableName() != "*(Ptr @ 0x20)" || static_cast<PatternPointer*>(clone.get())->getPointedAtPattern()->getVariableName() != "*(Ptr @ 0x20)")
+                return false;
+
+            // Naming the pattern afterwards replaces the stored name
+            pointedAt.setVariableName("named");
+            if (pointedAt.getVariableName() != "named")
+                return false;
+
+            pointedAt.setDereferencedName(*pointer);
+            return pointedAt.getVariableName() == "*(Ptr @ 0x20)" && pointedAt == *static_cast<PatternPointer*>(clone.get())->getPointedAtPattern();
+        }
     };
 
 }
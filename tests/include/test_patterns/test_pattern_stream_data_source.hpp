@@ -0,0 +1,74 @@
+#pragma once
+
+#include "test_pattern.hpp"
+
+#include <pl/core/evaluator.hpp>
+
+#include <algorithm>
+#include <vector>
+
+namespace pl::test {
+
+    class TestPatternStreamDataSource : public TestPattern {
+    public:
+        TestPatternStreamDataSource() : TestPattern("StreamDataSource") {
+
+        }
+        ~TestPatternStreamDataSource() override = default;
+
+        // Runs on the test data and on a stream of the same data, which need to behave the same way
+        [[nodiscard]] std::string getSourceCode() const override {
+            return R"(
+                u8 signature[8] @ 0x00;
+                std::assert(signature[0] == 0x89 && signature[7] == 0x0A, "Data at the start");
+
+                u32 late @ 0x28000;
+                std::assert(late == 0x4BE695EA, "Data far into the data");
+
+                u8 last @ 0x291E2;
+                std::assert(last == 0x82, "Data at the end");
+                std::assert(builtin::std::mem::size() == 0x291E3, "Size once the end has been reached");
+
+                std::assert(builtin::std::mem::read_unsigned(0x291DF, 8, 2) == 0x826042AE, "Data past the end is zero");
+            )";
+        }
+
+        [[nodiscard]] bool runRuntimeChecks(PatternLanguage &runtime) const override {
+            auto evaluator = runtime.getInternals().evaluator;
+
+            std::vector<u8> data(evaluator->getDataSize());
+            evaluator->readData(0x00, data.data(), data.size(), ptrn::Pattern::MainSectionId);
+
+            // Reading up to and past the end of the stream
+            const bool endValid = executeOnDataSource([&data](PatternLanguage &streamRuntime) {
+                setStream(streamRuntime, data);
+            }, this->getSourceCode());
+
+            // Reading data that has already been dropped from the window
+            const bool windowValid = executeOnDataSource([&data](PatternLanguage &streamRuntime) {
+                setStream(streamRuntime, data);
+            }, R"(
+                u32 late @ 0x28000;
+                std::assert(late == 0x4BE695EA, "Data far into the stream");
+                std::assert(builtin::std::mem::read_unsigned(0x20000, 1, 2) == 0xAE, "Data within the window");
+
+                builtin::std::mem::read_unsigned(0x00, 1, 2);
+            )", "E0011");
+
+            return endValid && windowValid;
+        }
+
+    private:
+        static void setStream(PatternLanguage &runtime, const std::vector<u8> &data) {
+            // Hand out the stream in small pieces the way a pipe would
+            runtime.setStreamDataSource([&data, position = u64(0)](u8 *buffer, size_t size) mutable -> size_t {
+                size = std::min<u64>({ size, 0x1000, data.size() - position });
+                std::copy_n(data.begin() + position, size, buffer);
+
+                position += size;
+                return size;
+            }, 0x10000);
+        }
+    };
+
+}
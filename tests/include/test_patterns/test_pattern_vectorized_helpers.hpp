@@ -0,0 +1,90 @@
+#pragma once
+
+#include "test_pattern.hpp"
+
+#include <pl/helpers/utils.hpp>
+
+#include <algorithm>
+#include <bit>
+#include <random>
+#include <vector>
+
+namespace pl::test {
+
+    class TestPatternVectorizedHelpers : public TestPattern {
+    public:
+        TestPatternVectorizedHelpers() : TestPattern("VectorizedHelpers") {
+
+        }
+        ~TestPatternVectorizedHelpers() override = default;
+
+        [[nodiscard]] std::string getSourceCode() const override {
+            return R"(
+                be u32 words[0x100] @ 0x00;
+            )";
+        }
+
+        [[nodiscard]] bool runRuntimeChecks(PatternLanguage &runtime) const override {
+            wolv::util::unused(runtime);
+
+            const auto instructionSets = hlp::getSupportedInstructionSets();
+            if (instructionSets.empty() || instructionSets.front() != hlp::InstructionSet::Scalar)
+                return false;
+
+            return std::ranges::all_of(instructionSets, [](auto instructionSet) {
+                return checkSwapByteOrder(instructionSet) && checkFloat16ToFloat32(instructionSet);
+            });
+        }
+
+    private:
+        // Counts around multiples of the vector widths leave different numbers of values for the scalar tail, the buffer
+        // is also used starting one byte in so no load or store is aligned
+        [[nodiscard]] static bool checkSwapByteOrder(hlp::InstructionSet instructionSet) {
+            std::mt19937_64 random(1234);
+
+            std::vector<u8> data(1024 * 8 + 1);
+            std::ranges::generate(data, [&] { return u8(random()); });
+
+            for (const size_t valueSize : { 2, 4, 8 }) {
+                for (const size_t count : { 0, 1, 2, 3, 4, 5, 7, 8, 9, 15, 16, 17, 31, 32, 33, 63, 64, 65, 1000, 1023, 1024 }) {
+                    for (const size_t start : { 0, 1 }) {
+                        std::vector<u8> swapped(data.begin() + start, data.begin() + start + valueSize * count);
+                        hlp::swapByteOrder(swapped.data(), valueSize, count, instructionSet);
+
+                        std::vector<u8> expected(data.begin() + start, data.begin() + start + valueSize * count);
+                        for (size_t i = 0; i < count; i++)
+                            std::reverse(expected.begin() + i * valueSize, expected.begin() + (i + 1) * valueSize);
+
+                        if (swapped != expected)
+                            return false;
+                    }
+                }
+            }
+
+            return true;
+        }
+
+        // Every possible half, including subnormals, infinities and NaNs, needs to convert to the same bits as the
+        // single value conversion. Converting from an offset leaves a tail the vector loop doesn't handle
+        [[nodiscard]] static bool checkFloat16ToFloat32(hlp::InstructionSet instructionSet) {
+            std::vector<u16> halfs(0x10000);
+            for (u32 i = 0; i < halfs.size(); i++)
+                halfs[i] = u16(i);
+
+            for (const size_t start : { 0, 3 }) {
+                const auto values = std::span<const u16>(halfs).subspan(start);
+
+                std::vector<float> result(values.size());
+                hlp::float16ToFloat32(values, result, instructionSet);
+
+                for (size_t i = 0; i < values.size(); i++) {
+                    if (std::bit_cast<u32>(result[i]) != std::bit_cast<u32>(hlp::float16ToFloat32(values[i])))
+                        return false;
+                }
+            }
+
+            return true;
+        }
+    };
+
+}
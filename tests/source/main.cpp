@@ -1,6 +1,8 @@
+#include <algorithm>
 #include <map>
 #include <string>
 #include <cstdlib>
+#include <cstring>
 
 #include <pl/helpers/utils.hpp>
 #include <wolv/io/file.hpp>
@@ -37,24 +39,26 @@ int runTests(int argc, char **argv) {
     const auto &currTest = testPatterns[testName];
     bool failing         = currTest->getMode() == Mode::Failing;
 
-    wolv::io::File testData("test_data", wolv::io::File::Mode::Read);
+    // Tests may modify the data, so work on a copy of it
+    auto testData = wolv::io::File("test_data", wolv::io::File::Mode::Read).readVector();
     pl::PatternLanguage runtime;
-    runtime.setDataSource(0x00, testData.getSize(), [&testData](u64 offset, u8 *buffer, u64 size) {
-        testData.seek(offset);
-        testData.readBuffer(buffer, size);
-    });
-
 
-    runtime.addFunction({ "std" }, "assert", api::FunctionParameterCount::exactly(2), [](core::Evaluator *ctx, auto params) -> std::optional<core::Token::Literal> {
-        auto condition = params[0].toBoolean();
-        auto message   = params[1].toString(false);
+    // Only the start of an access is checked against the data size, so clamp accesses reaching past its end
+    runtime.setDataSource(0x00, testData.size(), [&testData](u64 offset, u8 *buffer, u64 size) {
+        const auto available = offset < testData.size() ? std::min<u64>(size, testData.size() - offset) : 0;
 
-        if (!condition)
-            core::err::E0012.throwError(fmt::format("assertion failed \"{0}\"", message));
+        if (available > 0)
+            std::memcpy(buffer, testData.data() + offset, available);
+        std::memset(buffer + available, 0x00, size - available);
+    }, [&testData](u64 offset, const u8 *buffer, u64 size) {
+        const auto available = offset < testData.size() ? std::min<u64>(size, testData.size() - offset) : 0;
 
-        return std::nullopt;
+        if (available > 0)
+            std::memcpy(testData.data() + offset, buffer, available);
     });
 
+    TestPattern::addTestFunctions(runtime);
+
     auto &test = testPatterns[testName];
 
     auto result = runtime.executeString(test->getSourceCode());
@@ -76,7 +80,7 @@ int runTests(int argc, char **argv) {
     const auto &evaluatedPatterns = runtime.getAllPatterns();
     const auto &controlPatterns   = currTest->getPatterns();
 
-    if (!test->runChecks(evaluatedPatterns)) {
+    if (!test->runChecks(evaluatedPatterns) || !test->runRuntimeChecks(runtime)) {
         fmt::print("Post-run checks failed!\n");
 
         return failing ? EXIT_SUCCESS : EXIT_FAILURE;
@@ -19,6 +19,25 @@
 #include "test_patterns/test_pattern_nested_structs.hpp"
 #include "test_patterns/test_pattern_attributes.hpp"
 #include "test_patterns/test_pattern_struct_inheritance.hpp"
+#include "test_patterns/test_pattern_clones.hpp"
+#include "test_patterns/test_pattern_data_modification.hpp"
+#include "test_patterns/test_pattern_concurrent_queries.hpp"
+#include "test_patterns/test_pattern_math_reductions.hpp"
+#include "test_patterns/test_pattern_binary_results.hpp"
+#include "test_patterns/test_pattern_hash_vectors.hpp"
+#include "test_patterns/test_pattern_find_sequence.hpp"
+#include "test_patterns/test_pattern_find_signatures.hpp"
+#include "test_patterns/test_pattern_stream_data_source.hpp"
+#include "test_patterns/test_pattern_interval_index.hpp"
+#include "test_patterns/test_pattern_parallel_formatting.hpp"
+#include "test_patterns/test_pattern_address_index_modes.hpp"
+#include "test_patterns/test_pattern_pattern_sink.hpp"
+#include "test_patterns/test_pattern_append_mode.hpp"
+#include "test_patterns/test_pattern_array_values.hpp"
+#include "test_patterns/test_pattern_vectorized_helpers.hpp"
+#include "test_patterns/test_pattern_columnar_format.hpp"
+#include "test_patterns/test_pattern_html_format.hpp"
+#include "test_patterns/test_pattern_json_golden.hpp"
 
 std::array Tests = {
     TEST(Placement),
@@ -40,4 +59,23 @@ std::array Tests = {
     TEST(NestedStructs),
     TEST(Attributes),
     TEST(StructInheritance),
+    TEST(Clones),
+    TEST(DataModification),
+    TEST(ConcurrentQueries),
+    TEST(MathReductions),
+    TEST(BinaryResults),
+    TEST(HashVectors),
+    TEST(FindSequence),
+    TEST(FindSignatures),
+    TEST(StreamDataSource),
+    TEST(IntervalIndex),
+    TEST(ParallelFormatting),
+    TEST(AddressIndexModes),
+    TEST(PatternSink),
+    TEST(AppendMode),
+    TEST(ArrayValues),
+    TEST(VectorizedHelpers),
+    TEST(ColumnarFormat),
+    TEST(HtmlFormat),
+    TEST(JsonGolden),
 };
\ No newline at end of file